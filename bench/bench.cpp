@@ -0,0 +1,21 @@
+#include "bench.h"
+#include "stablevectorbench.h"
+#include "contiguousbench.h"
+#include "exceptionbench.h"
+#include "reallocbench.h"
+#include "instrumentbench.h"
+#include "threadcachebench.h"
+#include "objectpoolbench.h"
+#include "viewsbench.h"
+
+int main()
+{
+  StableVectorBench();
+  ContiguousBench();
+  ExceptionBench();
+  ReallocBench();
+  InstrumentBench();
+  ThreadCacheBench();
+  ObjectPoolBench();
+  ViewsBench();
+}
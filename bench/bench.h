@@ -0,0 +1,52 @@
+#ifndef EASYSTL_BENCH_H_
+#define EASYSTL_BENCH_H_
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// timing helpers shared by all benchmarks
+using BenchClock = std::chrono::steady_clock;
+
+inline int64_t NanosSince(BenchClock::time_point start) {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(BenchClock::now() - start).count();
+}
+
+// keep the optimizer from dropping a computed value
+template<class T>
+inline void DoNotOptimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+  asm volatile("" : : "r,m"(value) : "memory");
+#else
+  static volatile const T* sink;
+  sink = &value;
+#endif
+}
+
+// p-th percentile of samples, samples get sorted
+inline int64_t Percentile(std::vector<int64_t>& samples, double p) {
+  if (samples.empty()) { return 0; }
+  std::sort(samples.begin(), samples.end());
+  size_t index = static_cast<size_t>(p * (samples.size() - 1));
+  return samples[index];
+}
+
+// print one result line
+#define BENCH_LINE(name, value, unit) do {                                 \
+  std::cout << "  " << std::left << std::setw(44) << (name)                \
+            << std::right << std::setw(14) << (value) << " " << (unit)      \
+            << "\n";                                                        \
+} while(0)
+
+// run statement once and print the elapsed time in ms
+#define BENCH_TIME(name, statement) do {                                   \
+  auto bench_start_ = BenchClock::now();                                   \
+  statement;                                                               \
+  BENCH_LINE(name, NanosSince(bench_start_) / 1000000.0, "ms");           \
+} while(0)
+
+#endif // EASYSTL_BENCH_H_
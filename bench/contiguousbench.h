@@ -0,0 +1,106 @@
+
+#include <vector>
+#include "bench.h"
+#include "algo.h"
+#include "iterator.h"
+#include "uninitialized.h"
+#include "vector.h"
+
+// thin pointer wrapper, like the iterator of a user container
+// Tag decides what the library is allowed to know about it
+template<class T, class Tag>
+class WrappedIterator : public easystl::Iterator<Tag, T> {
+ public:
+  using Self = WrappedIterator<T, Tag>;
+  WrappedIterator() : p_(nullptr) {}
+  explicit WrappedIterator(T* p) : p_(p) {}
+  T& operator*() const { return *p_; }
+  T* operator->() const { return p_; }
+  T& operator[](ptrdiff_t n) const { return p_[n]; }
+  Self& operator++() { ++p_; return *this; }
+  Self operator++(int) { Self tmp = *this; ++p_; return tmp; }
+  Self& operator--() { --p_; return *this; }
+  Self operator--(int) { Self tmp = *this; --p_; return tmp; }
+  Self& operator+=(ptrdiff_t n) { p_ += n; return *this; }
+  Self& operator-=(ptrdiff_t n) { p_ -= n; return *this; }
+  Self operator+(ptrdiff_t n) const { return Self(p_ + n); }
+  Self operator-(ptrdiff_t n) const { return Self(p_ - n); }
+  ptrdiff_t operator-(const Self& rhs) const { return p_ - rhs.p_; }
+  bool operator==(const Self& rhs) const { return p_ == rhs.p_; }
+  bool operator!=(const Self& rhs) const { return p_ != rhs.p_; }
+  bool operator<(const Self& rhs) const { return p_ < rhs.p_; }
+
+ private:
+  T* p_;
+};
+
+template<class T>
+using RandomAccessWrapper = WrappedIterator<T, easystl::RandomAccessIteratorTag>;
+template<class T>
+using ContiguousWrapper = WrappedIterator<T, easystl::ContiguousIteratorTag>;
+
+// best of rounds, in ms
+template<class Func>
+double BestOf(int rounds, Func func) {
+  int64_t best = -1;
+  for (int i = 0; i < rounds; ++i) {
+    auto start = BenchClock::now();
+    func();
+    int64_t t = NanosSince(start);
+    if (best < 0 || t < best) { best = t; }
+  }
+  return best / 1000000.0;
+}
+
+template<class Iter, class T>
+void IteratorRound(const char* name, T* src, T* dst, size_t n) {
+  const int rounds = 20;
+  Iter first(src), last(src + n), result(dst);
+  std::cout << " " << name << " :\n";
+  BENCH_LINE("Copy", BestOf(rounds, [&] {
+    easystl::Copy(first, last, result);
+    DoNotOptimize(dst[n / 2]);
+  }), "ms");
+  BENCH_LINE("Copybackward", BestOf(rounds, [&] {
+    easystl::Copybackward(first, last, result + n);
+    DoNotOptimize(dst[n / 2]);
+  }), "ms");
+  BENCH_LINE("Fill", BestOf(rounds, [&] {
+    easystl::Fill(result, result + n, T(7));
+    DoNotOptimize(dst[n / 2]);
+  }), "ms");
+  BENCH_LINE("uninitialized_copy", BestOf(rounds, [&] {
+    easystl::uninitialized_copy(first, last, result);
+    DoNotOptimize(dst[n / 2]);
+  }), "ms");
+  BENCH_LINE("uninitialized_fill_n", BestOf(rounds, [&] {
+    easystl::uninitialized_fill_n(result, n, T(7));
+    DoNotOptimize(dst[n / 2]);
+  }), "ms");
+  BENCH_LINE("Distance", BestOf(rounds, [&] {
+    auto d = easystl::Distance(first, last);
+    DoNotOptimize(d);
+  }), "ms");
+  BENCH_LINE("vector(first, last)", BestOf(rounds, [&] {
+    easystl::vector<T> v(first, last);
+    DoNotOptimize(v[n / 2]);
+  }), "ms");
+}
+
+template<class T>
+void ContiguousBenchFor(const char* type, size_t n) {
+  std::vector<T> src(n, T(1)), dst(n);
+  std::cout << " value type " << type << ", " << n << " elements\n";
+  IteratorRound<T*>("raw pointer", src.data(), dst.data(), n);
+  IteratorRound<ContiguousWrapper<T>>("ContiguousWrapper", src.data(), dst.data(), n);
+  IteratorRound<RandomAccessWrapper<T>>("RandomAccessWrapper", src.data(), dst.data(), n);
+}
+
+void ContiguousBench()
+{
+  std::cout << "[----------------- contiguous iterator bench -----------------]\n";
+  ContiguousBenchFor<char>("char", 1 << 24);
+  ContiguousBenchFor<int>("int", 1 << 22);
+  ContiguousBenchFor<double>("double", 1 << 21);
+  std::cout << "[----------------- End -----------------]\n";
+}
@@ -0,0 +1,63 @@
+
+#include <vector>
+#include "bench.h"
+#include "vector.h"
+
+// same layout, different copy guarantees
+// NothrowValue   : user copy constructor marked noexcept
+// MayThrowValue  : user copy constructor that could throw but never does
+struct NothrowValue {
+  NothrowValue(int v = 0) noexcept : value(v) {}
+  NothrowValue(const NothrowValue& rhs) noexcept : value(rhs.value) {}
+  NothrowValue& operator=(const NothrowValue& rhs) noexcept { value = rhs.value; return *this; }
+  int value;
+};
+
+struct MayThrowValue {
+  MayThrowValue(int v = 0) : value(v) {}
+  MayThrowValue(const MayThrowValue& rhs) : value(rhs.value) {}
+  MayThrowValue& operator=(const MayThrowValue& rhs) { value = rhs.value; return *this; }
+  int value;
+};
+
+template<class Container>
+void GrowthRound(const char* name, size_t n) {
+  const int rounds = 10;
+  int64_t pushbest = -1, copybest = -1, insertbest = -1;
+  for (int r = 0; r < rounds; ++r) {
+    auto start = BenchClock::now();
+    Container c;
+    for (size_t i = 0; i < n; ++i) { c.push_back(static_cast<int>(i)); }
+    int64_t t = NanosSince(start);
+    if (pushbest < 0 || t < pushbest) { pushbest = t; }
+
+    start = BenchClock::now();
+    Container copy(c);
+    t = NanosSince(start);
+    DoNotOptimize(copy[n / 2]);
+    if (copybest < 0 || t < copybest) { copybest = t; }
+
+    start = BenchClock::now();
+    Container small;
+    for (size_t i = 0; i < 2000; ++i) { small.insert(small.begin(), 1, static_cast<int>(i)); }
+    t = NanosSince(start);
+    DoNotOptimize(small[0]);
+    if (insertbest < 0 || t < insertbest) { insertbest = t; }
+  }
+  std::cout << " " << name << " :\n";
+  BENCH_LINE("push_back x n", pushbest / 1000000.0, "ms");
+  BENCH_LINE("copy construct", copybest / 1000000.0, "ms");
+  BENCH_LINE("insert at front x 2000", insertbest / 1000000.0, "ms");
+}
+
+void ExceptionBench()
+{
+  std::cout << "[----------------- exception safety bench -----------------]\n";
+  const size_t n = 4000000;
+  GrowthRound<easystl::vector<int>>("easystl::vector<int>", n);
+  GrowthRound<std::vector<int>>("std::vector<int>", n);
+  GrowthRound<easystl::vector<NothrowValue>>("easystl::vector<NothrowValue>", n);
+  GrowthRound<easystl::vector<MayThrowValue>>("easystl::vector<MayThrowValue>", n);
+  GrowthRound<std::vector<MayThrowValue>>("std::vector<MayThrowValue>", n);
+  std::cout << "[----------------- End -----------------]\n";
+}
@@ -0,0 +1,237 @@
+#ifndef EASYSTL_INSTRUMENT_H_
+#define EASYSTL_INSTRUMENT_H_
+
+#include <cstdint>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+// counters shared by every CountingAllocator instantiation
+struct AllocCounters {
+  int64_t allocations;
+  int64_t deallocations;
+  int64_t reallocations;
+  int64_t bytesallocated;
+  int64_t bytesreallocated; // old size of reallocated blocks, upper bound of bytes moved
+  int64_t bytesinuse;
+  int64_t peakbytes;
+};
+
+inline AllocCounters& GetAllocCounters() {
+  static AllocCounters counters;
+  return counters;
+}
+
+// keeps bytesinuse, resets everything else
+inline void ResetAllocCounters() {
+  AllocCounters& c = GetAllocCounters();
+  int64_t inuse = c.bytesinuse;
+  std::memset(&c, 0, sizeof(c));
+  c.bytesinuse = inuse;
+  c.peakbytes = inuse;
+}
+
+// allocator adapter, same static interface as the easySTL allocators,
+// so it plugs into AllocatorWrapper and every container
+template<class Alloc>
+class CountingAllocator {
+ public:
+  static void* Allocate(size_t size) {
+    AllocCounters& c = GetAllocCounters();
+    ++c.allocations;
+    c.bytesallocated += size;
+    Grow(c, static_cast<int64_t>(size));
+    return Alloc::Allocate(size);
+  }
+  static void Deallocate(void *obj, size_t size) {
+    AllocCounters& c = GetAllocCounters();
+    ++c.deallocations;
+    c.bytesinuse -= size;
+    Alloc::Deallocate(obj, size);
+  }
+  static void* Reallocate(void *obj, size_t oldsize, size_t newsize) {
+    AllocCounters& c = GetAllocCounters();
+    ++c.reallocations;
+    c.bytesreallocated += oldsize;
+    Grow(c, static_cast<int64_t>(newsize) - static_cast<int64_t>(oldsize));
+    return Alloc::Reallocate(obj, oldsize, newsize);
+  }
+
+ private:
+  static void Grow(AllocCounters& c, int64_t bytes) {
+    c.bytesinuse += bytes;
+    if (c.bytesinuse > c.peakbytes) { c.peakbytes = c.bytesinuse; }
+  }
+};
+
+// counters of CountedValue
+struct ElementCounters {
+  int64_t constructs; // default and from int
+  int64_t copies;
+  int64_t copyassigns;
+  int64_t moves;
+  int64_t moveassigns;
+  int64_t destroys;
+};
+
+inline ElementCounters& GetElementCounters() {
+  static ElementCounters counters;
+  return counters;
+}
+
+inline void ResetElementCounters() { std::memset(&GetElementCounters(), 0, sizeof(ElementCounters)); }
+
+// element type that counts every special member call
+class CountedValue {
+ public:
+  CountedValue() : value(0) { ++GetElementCounters().constructs; }
+  CountedValue(int v) : value(v) { ++GetElementCounters().constructs; }
+  CountedValue(const CountedValue& rhs) : value(rhs.value) { ++GetElementCounters().copies; }
+  CountedValue(CountedValue&& rhs) noexcept : value(rhs.value) { ++GetElementCounters().moves; }
+  CountedValue& operator=(const CountedValue& rhs) {
+    value = rhs.value;
+    ++GetElementCounters().copyassigns;
+    return *this;
+  }
+  CountedValue& operator=(CountedValue&& rhs) noexcept {
+    value = rhs.value;
+    ++GetElementCounters().moveassigns;
+    return *this;
+  }
+  ~CountedValue() { ++GetElementCounters().destroys; }
+  int value;
+};
+
+// hardware counters around a region
+// cycles, instructions, L1d read misses and last level cache misses,
+// counted in user space for the calling thread. if perf_event_open
+// is not permitted (containers, perf_event_paranoid) Available()
+// is false and the values are left at zero
+class PerfCounters {
+ public:
+  enum { kCycles, kInstructions, kL1Misses, kLLCMisses, kCounterNums };
+
+  PerfCounters() {
+    for (int i = 0; i < kCounterNums; ++i) { fd_[i] = -1; values_[i] = 0; }
+#ifdef __linux__
+    const uint64_t l1miss = PERF_COUNT_HW_CACHE_L1D |
+                            (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                            (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+    Open(kCycles, PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES);
+    Open(kInstructions, PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS);
+    Open(kL1Misses, PERF_TYPE_HW_CACHE, l1miss);
+    Open(kLLCMisses, PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES);
+#endif
+  }
+  ~PerfCounters() {
+#ifdef __linux__
+    for (int i = 0; i < kCounterNums; ++i) { if (fd_[i] >= 0) { close(fd_[i]); } }
+#endif
+  }
+  PerfCounters(const PerfCounters&) = delete;
+  PerfCounters& operator=(const PerfCounters&) = delete;
+
+  bool Available() const { return fd_[kCycles] >= 0; }
+  void Start() {
+#ifdef __linux__
+    if (!Available()) { return; }
+    ioctl(fd_[kCycles], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(fd_[kCycles], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+#endif
+  }
+  void Stop() {
+#ifdef __linux__
+    if (!Available()) { return; }
+    ioctl(fd_[kCycles], PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+    for (int i = 0; i < kCounterNums; ++i) {
+      uint64_t value = 0;
+      if (fd_[i] >= 0 && read(fd_[i], &value, sizeof(value)) == sizeof(value)) { values_[i] = value; }
+      else { values_[i] = 0; }
+    }
+#endif
+  }
+  // value of counter i in the last Start/Stop region
+  uint64_t Value(int i) const { return values_[i]; }
+
+ private:
+#ifdef __linux__
+  // counters are grouped under the cycle counter so they cover
+  // exactly the same region; a missing event is just skipped
+  void Open(int index, uint32_t type, uint64_t config) {
+    if (index != kCycles && fd_[kCycles] < 0) { return; }
+    perf_event_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = type;
+    attr.config = config;
+    attr.disabled = index == kCycles ? 1 : 0;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    fd_[index] = static_cast<int>(syscall(__NR_perf_event_open, &attr, 0, -1,
+                                          index == kCycles ? -1 : fd_[kCycles], 0));
+  }
+#endif
+
+  int fd_[kCounterNums];
+  uint64_t values_[kCounterNums];
+};
+
+inline PerfCounters& GetPerfCounters() {
+  static PerfCounters counters;
+  return counters;
+}
+
+inline void InstrumentHeader() {
+  // bytes: allocated, rebytes: old size of reallocated blocks,
+  // peak: most bytes held at once during the operation
+  std::cout << "  " << std::left << std::setw(30) << "operation" << std::right
+            << std::setw(10) << "allocs" << std::setw(10) << "reallocs"
+            << std::setw(12) << "bytes" << std::setw(12) << "rebytes" << std::setw(12) << "peak"
+            << std::setw(10) << "ctors" << std::setw(10) << "copies"
+            << std::setw(10) << "assigns" << std::setw(8) << "moves"
+            << std::setw(10) << "dtors"
+            << std::setw(12) << "cycles" << std::setw(12) << "instrs"
+            << std::setw(10) << "L1miss" << std::setw(10) << "LLCmiss" << "\n";
+}
+
+inline void InstrumentLine(const std::string& name) {
+  const AllocCounters& a = GetAllocCounters();
+  const ElementCounters& e = GetElementCounters();
+  const PerfCounters& p = GetPerfCounters();
+  std::cout << "  " << std::left << std::setw(30) << name << std::right
+            << std::setw(10) << a.allocations << std::setw(10) << a.reallocations
+            << std::setw(12) << a.bytesallocated << std::setw(12) << a.bytesreallocated
+            << std::setw(12) << a.peakbytes
+            << std::setw(10) << e.constructs << std::setw(10) << e.copies
+            << std::setw(10) << e.copyassigns + e.moveassigns << std::setw(8) << e.moves
+            << std::setw(10) << e.destroys;
+  if (p.Available()) {
+    std::cout << std::setw(12) << p.Value(PerfCounters::kCycles)
+              << std::setw(12) << p.Value(PerfCounters::kInstructions)
+              << std::setw(10) << p.Value(PerfCounters::kL1Misses)
+              << std::setw(10) << p.Value(PerfCounters::kLLCMisses);
+  }
+  else {
+    std::cout << std::setw(12) << "-" << std::setw(12) << "-" << std::setw(10) << "-" << std::setw(10) << "-";
+  }
+  std::cout << "\n";
+}
+
+// run statement with fresh counters and print one row
+#define INSTRUMENT_OP(name, statement) do {                              \
+  ResetAllocCounters();                                                  \
+  ResetElementCounters();                                                \
+  GetPerfCounters().Start();                                             \
+  statement;                                                             \
+  GetPerfCounters().Stop();                                              \
+  InstrumentLine(name);                                                  \
+} while(0)
+
+#endif // EASYSTL_INSTRUMENT_H_
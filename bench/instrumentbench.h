@@ -0,0 +1,58 @@
+
+#include "bench.h"
+#include "instrument.h"
+#include "vector.h"
+#include "stable_vector.h"
+
+// per operation allocation, element and cache counters
+// an element-by-element relocation shows up as copies == size
+// on a growth step, a realloc growth as reallocs with zero copies
+template<class T>
+using CountedVector = easystl::vector<T, CountingAllocator<easystl::Allo>>;
+template<class T>
+using CountedStableVector = easystl::stable_vector<T, CountingAllocator<easystl::Allo>>;
+
+template<class Vector>
+void InstrumentVector(const char* name, int n) {
+  std::cout << " " << name << " :\n";
+  InstrumentHeader();
+  Vector v;
+  INSTRUMENT_OP("push_back x n", for (int i = 0; i < n; ++i) v.push_back(i));
+  INSTRUMENT_OP("push_back at capacity", while (v.size() < v.capacity()) v.push_back(0); v.push_back(1));
+  INSTRUMENT_OP("insert front x 1", v.insert(v.begin(), 1, 7));
+  INSTRUMENT_OP("insert middle x 100", v.insert(v.begin() + v.size() / 2, 100, 7));
+  Vector other;
+  INSTRUMENT_OP("copy construct", Vector copy(v); other.swap(copy));
+  INSTRUMENT_OP("copy assign (fits)", other = v);
+  INSTRUMENT_OP("erase front", v.erase(v.begin()));
+  INSTRUMENT_OP("erase half", v.erase(v.begin(), v.begin() + v.size() / 2));
+  INSTRUMENT_OP("resize x 2", v.resize(v.size() * 2));
+  INSTRUMENT_OP("clear", v.clear());
+}
+
+template<class Vector>
+void InstrumentStableVector(const char* name, int n) {
+  std::cout << " " << name << " :\n";
+  InstrumentHeader();
+  Vector v;
+  INSTRUMENT_OP("push_back x n", for (int i = 0; i < n; ++i) v.push_back(i));
+  INSTRUMENT_OP("push_back at capacity", while (v.size() < v.capacity()) v.push_back(0); v.push_back(1));
+  Vector other;
+  INSTRUMENT_OP("copy construct", Vector copy(v); other.swap(copy));
+  INSTRUMENT_OP("copy assign", other = v);
+  INSTRUMENT_OP("pop_back x n/2", for (int i = 0; i < n / 2; ++i) v.pop_back());
+  INSTRUMENT_OP("clear", v.clear());
+}
+
+void InstrumentBench()
+{
+  std::cout << "[----------------- instrumented container bench -----------------]\n";
+  if (!GetPerfCounters().Available()) {
+    std::cout << " perf_event_open not permitted, hardware counters disabled\n";
+  }
+  const int n = 1000000;
+  InstrumentVector<CountedVector<CountedValue>>("vector<CountedValue>", n);
+  InstrumentVector<CountedVector<int>>("vector<int>", n);
+  InstrumentStableVector<CountedStableVector<CountedValue>>("stable_vector<CountedValue>", n);
+  std::cout << "[----------------- End -----------------]\n";
+}
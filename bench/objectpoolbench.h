@@ -0,0 +1,81 @@
+
+#include <memory>
+#include <vector>
+#include "bench.h"
+#include "object_pool.h"
+
+// 64 byte entity, a typical game/simulation record
+struct BenchEntity {
+  explicit BenchEntity(int i) : id(i), hp(100), x(0), y(0), z(0), vx(1), vy(1), vz(1) {}
+  int id;
+  int hp;
+  double x, y, z, vx, vy, vz;
+};
+
+inline uint32_t NextRandom(uint32_t& x) {
+  x ^= x << 13; x ^= x >> 17; x ^= x << 5;
+  return x;
+}
+
+// live set of live objects, every step destroys a random one and
+// creates a new one; then one full sweep over the live objects
+void PoolChurn(size_t live, size_t steps) {
+  easystl::ObjectPool<BenchEntity> pool;
+  std::vector<easystl::ObjectHandle> handles(live);
+  uint32_t seed = 12345;
+  double sweep = 0;
+  BENCH_TIME("ObjectPool create x live", for (size_t i = 0; i < live; ++i) handles[i] = pool.CreateHandle(int(i)));
+  BENCH_TIME("ObjectPool churn", for (size_t i = 0; i < steps; ++i) {
+    size_t k = NextRandom(seed) % live;
+    pool.Destroy(handles[k]);
+    handles[k] = pool.CreateHandle(int(i));
+  });
+  BENCH_TIME("ObjectPool sweep (ForEach)", pool.ForEach([&sweep](BenchEntity& e) { e.x += e.vx; sweep += e.x; }));
+  BENCH_TIME("ObjectPool lookup by handle", for (auto h : handles) sweep += pool.Get(h)->hp);
+  BENCH_TIME("ObjectPool DestroyAll", pool.DestroyAll());
+  DoNotOptimize(sweep);
+}
+
+void NewDeleteChurn(size_t live, size_t steps) {
+  std::vector<BenchEntity*> objects(live);
+  uint32_t seed = 12345;
+  double sweep = 0;
+  BENCH_TIME("new create x live", for (size_t i = 0; i < live; ++i) objects[i] = new BenchEntity(int(i)));
+  BENCH_TIME("new/delete churn", for (size_t i = 0; i < steps; ++i) {
+    size_t k = NextRandom(seed) % live;
+    delete objects[k];
+    objects[k] = new BenchEntity(int(i));
+  });
+  BENCH_TIME("new/delete sweep", for (auto p : objects) { p->x += p->vx; sweep += p->x; });
+  BENCH_TIME("delete all", for (auto p : objects) delete p);
+  DoNotOptimize(sweep);
+}
+
+// unordered removal by swapping with the back, the usual pattern
+void UniquePtrChurn(size_t live, size_t steps) {
+  std::vector<std::unique_ptr<BenchEntity>> objects;
+  objects.reserve(live);
+  uint32_t seed = 12345;
+  double sweep = 0;
+  BENCH_TIME("unique_ptr create x live", for (size_t i = 0; i < live; ++i) objects.emplace_back(new BenchEntity(int(i))));
+  BENCH_TIME("unique_ptr churn", for (size_t i = 0; i < steps; ++i) {
+    size_t k = NextRandom(seed) % live;
+    std::swap(objects[k], objects.back());
+    objects.pop_back();
+    objects.emplace_back(new BenchEntity(int(i)));
+  });
+  BENCH_TIME("unique_ptr sweep", for (auto& p : objects) { p->x += p->vx; sweep += p->x; });
+  BENCH_TIME("unique_ptr clear", objects.clear());
+  DoNotOptimize(sweep);
+}
+
+void ObjectPoolBench()
+{
+  std::cout << "[----------------- object pool bench -----------------]\n";
+  const size_t live = 500000;
+  const size_t steps = 5000000;
+  PoolChurn(live, steps);
+  NewDeleteChurn(live, steps);
+  UniquePtrChurn(live, steps);
+  std::cout << "[----------------- End -----------------]\n";
+}
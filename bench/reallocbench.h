@@ -0,0 +1,61 @@
+
+#include <vector>
+#include "bench.h"
+#include "allocator.h"
+#include "vector.h"
+
+// the growth path vector used before Reallocate:
+// allocate a new block, copy everything, free the old one
+template<class Alloc>
+class CopyGrowAllocator {
+ public:
+  static void* Allocate(size_t size) { return Alloc::Allocate(size); }
+  static void Deallocate(void *obj, size_t size) { Alloc::Deallocate(obj, size); }
+  static void* Reallocate(void *obj, size_t oldsize, size_t newsize) {
+    void *result = Alloc::Allocate(newsize);
+    std::memcpy(result, obj, oldsize < newsize ? oldsize : newsize);
+    Alloc::Deallocate(obj, oldsize);
+    return result;
+  }
+};
+
+// push_back until the vector holds bytes bytes
+// reports total time and the slowest single push_back (one growth step)
+template<class Alloc>
+void GrowRound(const char* name, size_t bytes) {
+  const size_t n = bytes / sizeof(int);
+  int64_t maxlatency = 0;
+  auto start = BenchClock::now();
+  {
+    easystl::vector<int, Alloc> v;
+    for (size_t i = 0; i < n; ++i) {
+      if (v.size() == v.capacity()) {
+        auto growstart = BenchClock::now();
+        v.push_back(static_cast<int>(i));
+        int64_t t = NanosSince(growstart);
+        if (t > maxlatency) { maxlatency = t; }
+      }
+      else {
+        v.push_back(static_cast<int>(i));
+      }
+    }
+    DoNotOptimize(v[n / 2]);
+  }
+  int64_t total = NanosSince(start);
+  std::cout << " " << name << " :\n";
+  BENCH_LINE("grow to bytes total", total / 1000000.0, "ms");
+  BENCH_LINE("slowest growth step", maxlatency / 1000000.0, "ms");
+}
+
+void ReallocBench()
+{
+  std::cout << "[----------------- vector<int> realloc growth bench -----------------]\n";
+  const size_t bytes = 1000000000;
+  GrowRound<CopyGrowAllocator<easystl::MallocAllocator>>("allocate + copy + free", bytes);
+  GrowRound<easystl::MallocAllocator>("MallocAllocator::Reallocate (realloc)", bytes);
+  GrowRound<easystl::MemoryPoolAllocator>("MemoryPoolAllocator::Reallocate", bytes);
+#ifdef __linux__
+  GrowRound<easystl::MmapAllocator>("MmapAllocator::Reallocate (mremap)", bytes);
+#endif
+  std::cout << "[----------------- End -----------------]\n";
+}
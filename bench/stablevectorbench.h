@@ -0,0 +1,71 @@
+
+#include <vector>
+#include "bench.h"
+#include "vector.h"
+#include "stable_vector.h"
+
+// push_back latency distribution
+// every call is timed on its own, so the growth spikes of
+// vector show up in the tail while stable_vector stays flat
+template<class Container>
+void PushBackLatency(const char* name, size_t n) {
+  std::vector<int64_t> samples;
+  samples.reserve(n);
+  Container c;
+  for (size_t i = 0; i < n; ++i) {
+    auto start = BenchClock::now();
+    c.push_back(static_cast<int>(i));
+    samples.push_back(NanosSince(start));
+  }
+  DoNotOptimize(c.back());
+  int64_t maxlatency = *std::max_element(samples.begin(), samples.end());
+  std::cout << " " << name << " :\n";
+  BENCH_LINE("p50 push_back", Percentile(samples, 0.50), "ns");
+  BENCH_LINE("p99 push_back", Percentile(samples, 0.99), "ns");
+  BENCH_LINE("p999 push_back", Percentile(samples, 0.999), "ns");
+  BENCH_LINE("p9999 push_back", Percentile(samples, 0.9999), "ns");
+  BENCH_LINE("max push_back", maxlatency, "ns");
+}
+
+template<class Container>
+long long SumByIndex(Container& c) {
+  long long sum = 0;
+  for (size_t i = 0; i < c.size(); ++i) { sum += c[i]; }
+  return sum;
+}
+
+template<class Container>
+long long SumByIterator(Container& c) {
+  long long sum = 0;
+  for (auto it = c.begin(); it != c.end(); ++it) { sum += *it; }
+  return sum;
+}
+
+long long SumBySegment(easystl::stable_vector<int>& c) {
+  long long sum = 0;
+  c.for_each_segment([&sum](const int* first, const int* last) {
+    for (; first != last; ++first) { sum += *first; }
+  });
+  return sum;
+}
+
+void StableVectorBench()
+{
+  std::cout << "[----------------- stable_vector bench -----------------]\n";
+  const size_t n = 10000000;
+  PushBackLatency<easystl::vector<int>>("easystl::vector<int>", n);
+  PushBackLatency<easystl::stable_vector<int>>("easystl::stable_vector<int>", n);
+
+  easystl::vector<int> v;
+  easystl::stable_vector<int> sv;
+  BENCH_TIME("vector push_back total", for (size_t i = 0; i < n; ++i) v.push_back(int(i)));
+  BENCH_TIME("stable_vector push_back total", for (size_t i = 0; i < n; ++i) sv.push_back(int(i)));
+  long long sum = 0;
+  BENCH_TIME("vector sum by index", sum += SumByIndex(v));
+  BENCH_TIME("stable_vector sum by index", sum += SumByIndex(sv));
+  BENCH_TIME("vector sum by iterator", sum += SumByIterator(v));
+  BENCH_TIME("stable_vector sum by iterator", sum += SumByIterator(sv));
+  BENCH_TIME("stable_vector sum by segment", sum += SumBySegment(sv));
+  DoNotOptimize(sum);
+  std::cout << "[----------------- End -----------------]\n";
+}
@@ -0,0 +1,139 @@
+
+#include <atomic>
+#include <fstream>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "bench.h"
+#include "allocator.h"
+#include "thread_cache.h"
+
+// MemoryPoolAllocator is one global pool, it needs a lock to be shared
+class LockedPoolAllocator {
+ public:
+  static void* Allocate(size_t size) {
+    std::lock_guard<std::mutex> lock(Lock());
+    return easystl::MemoryPoolAllocator::Allocate(size);
+  }
+  static void Deallocate(void *obj, size_t size) {
+    std::lock_guard<std::mutex> lock(Lock());
+    easystl::MemoryPoolAllocator::Deallocate(obj, size);
+  }
+
+ private:
+  static std::mutex& Lock() {
+    static std::mutex lock;
+    return lock;
+  }
+};
+
+// single producer single consumer ring of (pointer, size)
+class HandoffRing {
+ public:
+  struct Item { void* p; size_t size; };
+  HandoffRing() : head_(0), tail_(0) {}
+  bool Push(const Item& item) {
+    size_t tail = tail_.load(std::memory_order_relaxed);
+    if (tail - head_.load(std::memory_order_acquire) == kRingSize) { return false; }
+    items_[tail % kRingSize] = item;
+    tail_.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+  bool Pop(Item& item) {
+    size_t head = head_.load(std::memory_order_relaxed);
+    if (head == tail_.load(std::memory_order_acquire)) { return false; }
+    item = items_[head % kRingSize];
+    head_.store(head + 1, std::memory_order_release);
+    return true;
+  }
+
+ private:
+  static constexpr size_t kRingSize = 4096;
+  Item items_[kRingSize];
+  alignas(64) std::atomic<size_t> head_;
+  alignas(64) std::atomic<size_t> tail_;
+};
+
+// resident set size in bytes
+inline size_t ResidentBytes() {
+  std::ifstream statm("/proc/self/statm");
+  size_t pages = 0, resident = 0;
+  statm >> pages >> resident;
+  return resident * 4096;
+}
+
+// producers allocate on their own thread, consumers free on theirs
+// reports throughput, resident memory sampled over time and the
+// latency of a cross-thread free
+template<class Alloc>
+void ProducerConsumerRound(const char* name, int pairs, size_t perproducer) {
+  std::vector<HandoffRing> rings(pairs);
+  std::vector<std::vector<int64_t>> latency(pairs);
+  std::atomic<int> running(pairs);
+  std::vector<size_t> rss;
+  const size_t rssstart = ResidentBytes();
+  auto start = BenchClock::now();
+  std::vector<std::thread> threads;
+  for (int i = 0; i < pairs; ++i) {
+    threads.emplace_back([&rings, i, perproducer] {
+      uint32_t x = 2463534242u + i;
+      for (size_t n = 0; n < perproducer; ++n) {
+        x ^= x << 13; x ^= x >> 17; x ^= x << 5;
+        size_t size = 8 + (x % 16) * 8;
+        void* p = Alloc::Allocate(size);
+        static_cast<char*>(p)[0] = 1;
+        while (!rings[i].Push({p, size})) { std::this_thread::yield(); }
+      }
+    });
+    threads.emplace_back([&rings, &latency, &running, i, perproducer] {
+      latency[i].reserve(perproducer / 16 + 1);
+      HandoffRing::Item item;
+      for (size_t n = 0; n < perproducer; ++n) {
+        while (!rings[i].Pop(item)) { std::this_thread::yield(); }
+        if ((n & 15) == 0) {
+          auto freestart = BenchClock::now();
+          Alloc::Deallocate(item.p, item.size);
+          latency[i].push_back(NanosSince(freestart));
+        }
+        else {
+          Alloc::Deallocate(item.p, item.size);
+        }
+      }
+      --running;
+    });
+  }
+  while (running.load() > 0) {
+    rss.push_back(ResidentBytes());
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  }
+  for (auto& t : threads) { t.join(); }
+  int64_t total = NanosSince(start);
+  std::vector<int64_t> all;
+  for (auto& l : latency) { all.insert(all.end(), l.begin(), l.end()); }
+  std::cout << " " << name << " :\n";
+  BENCH_LINE("throughput", pairs * perproducer / (total / 1e9) / 1e6, "M objects/s");
+  BENCH_LINE("free latency p50", Percentile(all, 0.50), "ns");
+  BENCH_LINE("free latency p99", Percentile(all, 0.99), "ns");
+  BENCH_LINE("free latency p999", Percentile(all, 0.999), "ns");
+  std::cout << "  resident growth over time (KB):";
+  size_t step = rss.size() / 8 + 1;
+  for (size_t i = 0; i < rss.size(); i += step) {
+    std::cout << " " << (static_cast<int64_t>(rss[i]) - static_cast<int64_t>(rssstart)) / 1024;
+  }
+  std::cout << " " << (static_cast<int64_t>(ResidentBytes()) - static_cast<int64_t>(rssstart)) / 1024 << "\n";
+}
+
+void ThreadCacheBench()
+{
+  std::cout << "[----------------- producer/consumer allocator bench -----------------]\n";
+  const int pairs = 2;
+  const size_t perproducer = 2000000;
+  for (int round = 0; round < 2; ++round) {
+    std::cout << " round " << round << "\n";
+    ProducerConsumerRound<easystl::MallocAllocator>("MallocAllocator", pairs, perproducer);
+    ProducerConsumerRound<LockedPoolAllocator>("MemoryPoolAllocator + mutex", pairs, perproducer);
+    ProducerConsumerRound<easystl::ThreadCacheAllocator>("ThreadCacheAllocator", pairs, perproducer);
+    BENCH_LINE("ThreadCacheAllocator chunk bytes", easystl::ThreadCacheAllocator::ChunkBytes(), "B");
+  }
+  std::cout << "[----------------- End -----------------]\n";
+}
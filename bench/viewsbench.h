@@ -0,0 +1,79 @@
+#include "bench.h"
+#include "instrument.h"
+#include "vector.h"
+#include "views.h"
+
+using CountedIntVector = easystl::vector<int, CountingAllocator<easystl::Allo>>;
+
+// one run: time, peak bytes and allocations of everything the
+// pipeline allocated (the source is not counted)
+template<class Func>
+void ViewsRun(const char* name, Func func) {
+  ResetAllocCounters();
+  int64_t check = 0;
+  auto start = BenchClock::now();
+  {
+    CountedIntVector result = func();
+    check = static_cast<int64_t>(result.size()) + (result.empty() ? 0 : result.back());
+    DoNotOptimize(check);
+  }
+  const double ms = NanosSince(start) / 1000000.0;
+  const AllocCounters& c = GetAllocCounters();
+  std::cout << "  " << name << "\n";
+  BENCH_LINE("    time", ms, "ms");
+  BENCH_LINE("    peak memory", c.peakbytes / (1024.0 * 1024.0), "MiB");
+  BENCH_LINE("    allocations + reallocations", c.allocations + c.reallocations, "");
+  BENCH_LINE("    result check", check, "");
+}
+
+// each stage writes a temporary vector that the next stage reads
+template<class Pred, class Func>
+CountedIntVector ChainedStages(const easystl::vector<int>& src, Pred pred, Func func, size_t n) {
+  CountedIntVector filtered;
+  for (int x : src) { if (pred(x)) filtered.push_back(x); }
+  CountedIntVector transformed;
+  for (int x : filtered) { transformed.push_back(func(x)); }
+  CountedIntVector taken;
+  for (size_t i = 0; i < n && i < transformed.size(); ++i) { taken.push_back(transformed[i]); }
+  return taken;
+}
+
+// length known at every stage, so each temporary is sized up front
+template<class Func>
+CountedIntVector ChainedSized(const easystl::vector<int>& src, Func func, size_t drop, size_t take) {
+  CountedIntVector transformed;
+  transformed.reserve(src.size());
+  for (int x : src) { transformed.push_back(func(x)); }
+  CountedIntVector dropped;
+  dropped.reserve(transformed.size() - drop);
+  for (size_t i = drop; i < transformed.size(); ++i) { dropped.push_back(transformed[i]); }
+  CountedIntVector taken;
+  taken.reserve(take);
+  for (size_t i = 0; i < take; ++i) { taken.push_back(dropped[i]); }
+  return taken;
+}
+
+void ViewsBench()
+{
+  std::cout << "[----------------- views bench -----------------]\n";
+  const size_t n = 10000000;
+  easystl::vector<int> src;
+  src.reserve(n);
+  for (size_t i = 0; i < n; ++i) src.push_back(static_cast<int>(i));
+  auto pred = [](int x) { return x % 3 != 0; };
+  auto func = [](int x) { return x * 2 + 1; };
+
+  std::cout << " filter | transform | take(n/2), 1e7 ints\n";
+  ViewsRun("chained temporary vectors", [&] { return ChainedStages(src, pred, func, n / 2); });
+  ViewsRun("fused views", [&] {
+    return easystl::views::ToVector<CountingAllocator<easystl::Allo>>(
+      src | easystl::views::filter(pred) | easystl::views::transform(func) | easystl::views::take(n / 2));
+  });
+  std::cout << " transform | drop(n/4) | take(n/2), 1e7 ints, length known\n";
+  ViewsRun("chained temporary vectors, reserved", [&] { return ChainedSized(src, func, n / 4, n / 2); });
+  ViewsRun("fused views", [&] {
+    return easystl::views::ToVector<CountingAllocator<easystl::Allo>>(
+      src | easystl::views::transform(func) | easystl::views::drop(n / 4) | easystl::views::take(n / 2));
+  });
+  std::cout << "[----------------- End -----------------]\n";
+}
@@ -1,13 +1,20 @@
 #ifndef EASYSTL_ALGO_H_
 #define EASYSTL_ALGO_H_
 
+#include <cstring>
+#include "iterator.h"
+
 namespace easystl {
 
 template <typename T>
 inline const T& Max(const T& a, const T& b) noexcept { return a > b ? a : b; }
 
+// element by element copy
+// the element by element paths throw whatever T's assignment throws,
+// the memmove/memset paths never throw
 template <typename InputIterator, typename OutputIterator>
-OutputIterator Copy(InputIterator first, InputIterator last, OutputIterator result) noexcept {
+OutputIterator __Copy(InputIterator first, InputIterator last, OutputIterator result, FalseType)
+  noexcept(std::is_nothrow_assignable<decltype(*result), decltype(*first)>::value) {
   while (first != last) {
     *result = *first;
     ++result;
@@ -16,24 +23,87 @@ OutputIterator Copy(InputIterator first, InputIterator last, OutputIterator resu
   return result;
 }
 
+// contiguous and trivially copyable, one memmove
+template <typename InputIterator, typename OutputIterator>
+OutputIterator __Copy(InputIterator first, InputIterator last, OutputIterator result, TrueType) noexcept {
+  const auto n = last - first;
+  if (n > 0) {
+    std::memmove(ToAddress(result), ToAddress(first), static_cast<size_t>(n) * sizeof(*ToAddress(first)));
+  }
+  return result + n;
+}
+
+template <typename InputIterator, typename OutputIterator>
+OutputIterator Copy(InputIterator first, InputIterator last, OutputIterator result)
+  noexcept(noexcept(__Copy(first, last, result, IsMemCopyable<InputIterator, OutputIterator>()))) {
+  return __Copy(first, last, result, IsMemCopyable<InputIterator, OutputIterator>());
+}
+
 template <typename BidirectionalIterator1, typename BidirectionalIterator2>
-BidirectionalIterator2 Copybackward(BidirectionalIterator1 first, BidirectionalIterator1 last, BidirectionalIterator2 result) noexcept {
+BidirectionalIterator2 __Copybackward(BidirectionalIterator1 first, BidirectionalIterator1 last, BidirectionalIterator2 result, FalseType)
+  noexcept(std::is_nothrow_assignable<decltype(*result), decltype(*last)>::value) {
   while (first != last) { 
     *(--result) = *(--last); 
   }
   return result;
 }
 
+template <typename BidirectionalIterator1, typename BidirectionalIterator2>
+BidirectionalIterator2 __Copybackward(BidirectionalIterator1 first, BidirectionalIterator1 last, BidirectionalIterator2 result, TrueType) noexcept {
+  const auto n = last - first;
+  result -= n;
+  if (n > 0) {
+    std::memmove(ToAddress(result), ToAddress(first), static_cast<size_t>(n) * sizeof(*ToAddress(first)));
+  }
+  return result;
+}
+
+template <typename BidirectionalIterator1, typename BidirectionalIterator2>
+BidirectionalIterator2 Copybackward(BidirectionalIterator1 first, BidirectionalIterator1 last, BidirectionalIterator2 result)
+  noexcept(noexcept(__Copybackward(first, last, result, IsMemCopyable<BidirectionalIterator1, BidirectionalIterator2>()))) {
+  return __Copybackward(first, last, result, IsMemCopyable<BidirectionalIterator1, BidirectionalIterator2>());
+}
+
 template <typename ForwardIterator, typename T>
-void Fill(ForwardIterator first, ForwardIterator last, const T& value) noexcept {
+void __Fill(ForwardIterator first, ForwardIterator last, const T& value, FalseType)
+  noexcept(std::is_nothrow_assignable<decltype(*first), const T&>::value) {
   while (first != last) {
     *first = value;
     ++first;
   }
 }
 
+// byte sized values turn into a memset
+template <typename T>
+void __FillPointer(T* p, size_t n, const T& value, TrueType) noexcept {
+  unsigned char byte;
+  std::memcpy(&byte, &value, 1);
+  std::memset(static_cast<void*>(p), byte, n);
+}
+
+template <typename T>
+void __FillPointer(T* p, size_t n, const T& value, FalseType) noexcept {
+  const T tmp = value;
+  for (T* end = p + n; p != end; ++p) { *p = tmp; }
+}
+
+// contiguous, fill through a raw pointer so the loop can be vectorized
+template <typename ForwardIterator, typename T>
+void __Fill(ForwardIterator first, ForwardIterator last, const T& value, TrueType) noexcept {
+  const auto n = last - first;
+  if (n <= 0) { return; }
+  __FillPointer(ToAddress(first), static_cast<size_t>(n), value, BoolConstant<sizeof(T) == 1>());
+}
+
+template <typename ForwardIterator, typename T>
+void Fill(ForwardIterator first, ForwardIterator last, const T& value)
+  noexcept(noexcept(__Fill(first, last, value, IsMemFillable<ForwardIterator, T>()))) {
+  __Fill(first, last, value, IsMemFillable<ForwardIterator, T>());
+}
+
 template <typename T>
-void Swap(T& a, T& b) noexcept {
+void Swap(T& a, T& b)
+  noexcept(std::is_nothrow_copy_constructible<T>::value && std::is_nothrow_copy_assignable<T>::value) {
   T temp = a;
   a = b;
   b = temp;
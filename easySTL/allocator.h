@@ -2,6 +2,11 @@
 #define EASYSTL_ALLOCATOR_H_
 
 #include <cstdlib>
+#include <cstring>
+#ifdef __linux__
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
 
 namespace easystl {
 // malloc allocator
@@ -120,11 +125,20 @@ class MemoryPoolAllocator {
     freelist_[GetFreelistIndex(size)].Push(obj);
   }
   static void* Reallocate(void *obj, size_t oldsize, size_t newsize) {
-    if (RoundUp(newsize) == RoundUp(oldsize)) { 
+    if (nullptr == obj) { return Allocate(newsize); }
+    // both blocks belong to malloc, let realloc grow in place
+    if (oldsize > size_t(kMaxBytes) && newsize > size_t(kMaxBytes)) {
+      return MallocAllocator::Reallocate(obj, oldsize, newsize);
+    }
+    if (oldsize <= size_t(kMaxBytes) && newsize <= size_t(kMaxBytes) &&
+        RoundUp(newsize) == RoundUp(oldsize)) { 
       return obj; // No need to reallocate if sizes are equal
     }
-    Deallocate(obj, oldsize);  // Free the old memory
-    return Allocate(newsize);  // Allocate new memory
+    // keep the data: allocate, copy, then free the old memory
+    void *result = Allocate(newsize);
+    std::memcpy(result, obj, oldsize < newsize ? oldsize : newsize);
+    Deallocate(obj, oldsize);
+    return result;
   }
 
  private:
@@ -201,6 +215,58 @@ void* MemoryPoolAllocator::ReFill(size_t size) {
   return chunk;
 }
 
+#ifdef __linux__
+// mmap allocator
+// blocks of at least kMmapThreshold bytes are mapped directly,
+// smaller ones go to MallocAllocator. deallocation is sized, so
+// the size tells which of the two owns a block, and growing a
+// mapped block uses mremap: the kernel moves page table entries
+// instead of copying the bytes
+static constexpr size_t kMmapThreshold = size_t(1) << 20;
+
+class MmapAllocator {
+ public:
+  static void* Allocate(size_t size) {
+    if (size < kMmapThreshold) { return MallocAllocator::Allocate(size); }
+    return Map(RoundUpPage(size));
+  }
+  static void Deallocate(void *obj, size_t size) {
+    if (size < kMmapThreshold) {
+      MallocAllocator::Deallocate(obj, size);
+      return ;
+    }
+    munmap(obj, RoundUpPage(size));
+  }
+  static void* Reallocate(void *obj, size_t oldsize, size_t newsize) {
+    if (nullptr == obj) { return Allocate(newsize); }
+    if (oldsize < kMmapThreshold && newsize < kMmapThreshold) {
+      return MallocAllocator::Reallocate(obj, oldsize, newsize);
+    }
+    if (oldsize >= kMmapThreshold && newsize >= kMmapThreshold) {
+      void *result = mremap(obj, RoundUpPage(oldsize), RoundUpPage(newsize), MREMAP_MAYMOVE);
+      if (MAP_FAILED == result) { std::abort(); }
+      return result;
+    }
+    // crossing the threshold, one copy
+    void *result = Allocate(newsize);
+    std::memcpy(result, obj, oldsize < newsize ? oldsize : newsize);
+    Deallocate(obj, oldsize);
+    return result;
+  }
+
+ private:
+  static size_t RoundUpPage(size_t bytes) {
+    static const size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    return (bytes + page - 1) & ~(page - 1);
+  }
+  static void* Map(size_t size) {
+    void *result = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (MAP_FAILED == result) { std::abort(); }
+    return result;
+  }
+};
+#endif // __linux__
+
 #define USEMALLOC
 #ifdef USEMALLOC
 using Allo = MemoryPoolAllocator;
@@ -215,6 +281,11 @@ class AllocatorWrapper {
   static T * Allocate(void) { return (T*)Allocator::Allocate(sizeof(T)); }
   static void Deallocate(T * p, size_t n) { if(0 != n) { Allocator::Deallocate(p, n*sizeof(T)); } }
   static void Deallocate(T * p) { Allocator::Deallocate(p, sizeof(T)); }
+  // only for trivially copyable T, the bytes are moved as they are
+  static T * Reallocate(T * p, size_t oldn, size_t newn) {
+    if (0 == oldn) { return Allocate(newn); }
+    return (T*)Allocator::Reallocate(p, oldn*sizeof(T), newn*sizeof(T));
+  }
 };
 
 } // namespace easystl
@@ -2,6 +2,7 @@
 #define EASYSTL_CONSTRUCTOR_H_
 
 #include <new>
+#include <utility>
 
 namespace easystl {
 
@@ -11,6 +12,9 @@ inline void Construct(T* p) { new(p) T(); }
 template<class T1, class T2>
 inline void Construct(T1* p, const T2 & value) { new(p) T1(value); }
 
+template<class T, class... Args>
+inline void Construct(T* p, Args&&... args) { new(p) T(std::forward<Args>(args)...); }
+
 template<class T>
 inline void Destroy(T* p) { p->~T(); }
 
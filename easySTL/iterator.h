@@ -2,6 +2,7 @@
 #define EASYSTL_ITERATOR_H_
 
 #include <cstddef>
+#include <type_traits>
 
 namespace easystl {
 
@@ -17,11 +18,21 @@ class FalseType {
 
 template<typename...> using void_t = void;
 
+template<bool B>
+using BoolConstant = typename std::conditional<B, TrueType, FalseType>::type;
+
+// types that can be copied with memmove
+template<class T>
+class IsTriviallyCopyable : public BoolConstant<std::is_trivially_copyable<T>::value> {};
+
 class InputIteratorTag {};
 class OutputIteratorTag {};
 class ForwardIteratorTag : public InputIteratorTag {};
 class BidirectionalIteratorTag : public ForwardIteratorTag {};
 class RandomAccessIteratorTag : public BidirectionalIteratorTag {};
+// random access iterator whose elements are adjacent in memory
+// &*(it + n) == &*it + n
+class ContiguousIteratorTag : public RandomAccessIteratorTag {};
 
 template<class Category,
          class T,
@@ -53,7 +64,7 @@ public:
 template<class T>
 class IteratorTraits<T*, void> {
 public:
-  using IteratorCategory = RandomAccessIteratorTag;
+  using IteratorCategory = ContiguousIteratorTag;
   using ValueType = T;
   using Pointer = T*;
   using Reference = T&;
@@ -63,7 +74,7 @@ public:
 template<class T>
 class IteratorTraits<const T*, void> {
 public:
-  using IteratorCategory = RandomAccessIteratorTag;
+  using IteratorCategory = ContiguousIteratorTag;
   using ValueType = T;
   using Pointer = const T*;
   using Reference = const T&;
@@ -81,6 +92,46 @@ public:
   static const bool value = decltype(test<T>(0))::value;
 };
 
+template<class T, class = void>
+class IsContiguousIterator : public FalseType {};
+
+template<class T>
+class IsContiguousIterator<T, void_t<typename IteratorTraits<T>::IteratorCategory>>
+  : public BoolConstant<std::is_base_of<ContiguousIteratorTag,
+                                        typename IteratorTraits<T>::IteratorCategory>::value> {};
+
+// [first, last) -> result can be done with memmove:
+// both sides contiguous, same value type, trivially copyable
+template<class InputIter, class OutputIter, class = void>
+class IsMemCopyable : public FalseType {};
+
+template<class InputIter, class OutputIter>
+class IsMemCopyable<InputIter, OutputIter,
+  std::enable_if_t<IsContiguousIterator<InputIter>::value && IsContiguousIterator<OutputIter>::value>>
+  : public BoolConstant<
+      std::is_same<typename std::remove_cv<typename IteratorTraits<InputIter>::ValueType>::type,
+                   typename std::remove_cv<typename IteratorTraits<OutputIter>::ValueType>::type>::value &&
+      IsTriviallyCopyable<typename IteratorTraits<OutputIter>::ValueType>::value> {};
+
+// filling [first, last) with value can be done on a raw pointer
+template<class ForwardIter, class T, class = void>
+class IsMemFillable : public FalseType {};
+
+template<class ForwardIter, class T>
+class IsMemFillable<ForwardIter, T,
+  std::enable_if_t<IsContiguousIterator<ForwardIter>::value>>
+  : public BoolConstant<
+      std::is_same<typename std::remove_cv<typename IteratorTraits<ForwardIter>::ValueType>::type,
+                   typename std::remove_cv<T>::type>::value &&
+      IsTriviallyCopyable<T>::value> {};
+
+// raw pointer of a contiguous iterator
+template<class ContiguousIter>
+inline auto ToAddress(ContiguousIter it) noexcept -> decltype(&*it) { return &*it; }
+
+template<class T>
+inline T* ToAddress(T* p) noexcept { return p; }
+
 template<class Iterator>
 inline typename IteratorTraits<Iterator>::IteratorCategory
 IteratorCategory(const Iterator&) {
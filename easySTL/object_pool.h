@@ -0,0 +1,235 @@
+#ifndef EASYSTL_OBJECT_POOL_H_
+#define EASYSTL_OBJECT_POOL_H_
+
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+#include <utility>
+#include "allocator.h"
+#include "constructor.h"
+#include "vector.h"
+
+namespace easystl {
+
+// 32 bit handle of a pooled object
+// low kObjectIndexBits bits are the slot index, the rest is the
+// generation of the slot when the object was created. destroying
+// an object bumps the generation, so an old handle no longer
+// matches and lookups through it fail instead of touching a new
+// object. a slot whose generation is used up is retired rather
+// than wrapped, so no handle ever becomes valid again. value 0 is
+// never handed out.
+static constexpr uint32_t kObjectIndexBits = 20;
+static constexpr uint32_t kObjectIndexMask = (uint32_t(1) << kObjectIndexBits) - 1;
+static constexpr uint32_t kObjectGenerationMask = (uint32_t(1) << (32 - kObjectIndexBits)) - 1;
+static constexpr size_t kObjectPoolSlabBytes = 4096;
+
+class ObjectHandle {
+ public:
+  ObjectHandle() noexcept : value(0) {}
+  explicit ObjectHandle(uint32_t v) noexcept : value(v) {}
+  ObjectHandle(uint32_t index, uint32_t generation) noexcept
+    : value(index | (generation << kObjectIndexBits)) {}
+  uint32_t Index() const noexcept { return value & kObjectIndexMask; }
+  uint32_t Generation() const noexcept { return value >> kObjectIndexBits; }
+  explicit operator bool() const noexcept { return value != 0; }
+  bool operator==(const ObjectHandle& rhs) const noexcept { return value == rhs.value; }
+  bool operator!=(const ObjectHandle& rhs) const noexcept { return value != rhs.value; }
+  uint32_t value;
+};
+
+// typed slab allocator
+// objects live in slabs of about one page, slots are reused through
+// a free list and never move, so raw pointers stay valid until the
+// object is destroyed. live objects can be visited slab by slab.
+// a pool holds at most 2^kObjectIndexBits slots, retired ones
+// included; creating past that throws std::length_error.
+template<class T, class Alloc = Allo>
+class ObjectPool {
+ public:
+  using Handle = ObjectHandle;
+  using size_type = size_t;
+  static constexpr size_type kSlabObjects =
+    sizeof(T) >= kObjectPoolSlabBytes ? 1 : kObjectPoolSlabBytes / sizeof(T);
+
+  ObjectPool() noexcept : freehead_(kNoSlot), size_(0) {}
+  ObjectPool(const ObjectPool&) = delete;
+  ObjectPool& operator=(const ObjectPool&) = delete;
+  ~ObjectPool() {
+    DestroyAll();
+    for (size_type i = 0; i < slabs_.size(); ++i) {
+      SlabAllocator::Deallocate(slabs_[i], kSlabObjects);
+    }
+  }
+
+  // construct an object with args, the slot is released if T's constructor throws
+  template<class... Args>
+  T* Create(Args&&... args) {
+    return Address(CreateSlot(std::forward<Args>(args)...));
+  }
+  template<class... Args>
+  Handle CreateHandle(Args&&... args) {
+    const uint32_t slot = CreateSlot(std::forward<Args>(args)...);
+    return Handle(slot, generations_[slot]);
+  }
+  // nullptr when the handle is stale or was never valid
+  T* Get(Handle h) const noexcept {
+    const uint32_t slot = h.Index();
+    if (slot >= generations_.size() || nextfree_[slot] != kLive ||
+        generations_[slot] != h.Generation()) {
+      return nullptr;
+    }
+    return Address(slot);
+  }
+  bool Valid(Handle h) const noexcept { return Get(h) != nullptr; }
+  // handle of a live object created by this pool, an empty handle otherwise
+  Handle HandleOf(const T* p) const noexcept {
+    const uint32_t slot = SlotOf(p);
+    if (slot == kNoSlot || nextfree_[slot] != kLive) { return Handle(); }
+    return Handle(slot, generations_[slot]);
+  }
+  // false for a stale handle, nothing is destroyed then
+  bool Destroy(Handle h) {
+    if (!Get(h)) { return false; }
+    DestroySlot(h.Index());
+    return true;
+  }
+  // false when p is not a live object of this pool
+  bool Destroy(T* p) {
+    const uint32_t slot = SlotOf(p);
+    if (slot == kNoSlot || nextfree_[slot] != kLive) { return false; }
+    DestroySlot(slot);
+    return true;
+  }
+  // destroy every live object, slabs are kept and every
+  // outstanding handle becomes stale
+  void DestroyAll() {
+    freehead_ = kNoSlot;
+    for (size_type i = generations_.size(); i > 0; --i) {
+      const uint32_t slot = static_cast<uint32_t>(i - 1);
+      if (nextfree_[slot] == kLive) {
+        easystl::Destroy(Address(slot));
+        if (Retire(slot)) { continue; }
+      }
+      else if (nextfree_[slot] == kRetired) {
+        continue;
+      }
+      // rebuilt in ascending order, new objects fill slabs front to back
+      nextfree_[slot] = freehead_;
+      freehead_ = slot;
+    }
+    size_ = 0;
+  }
+  // func(T&) for every live object, in slab order
+  template<class Func>
+  void ForEach(Func func) {
+    for (size_type s = 0; s < slabs_.size(); ++s) {
+      T* slab = slabs_[s];
+      const uint32_t* state = &nextfree_[0] + s * kSlabObjects;
+      for (size_type i = 0; i < kSlabObjects; ++i) {
+        if (state[i] == kLive) { func(slab[i]); }
+      }
+    }
+  }
+
+  size_type size() const noexcept { return size_; }
+  bool empty() const noexcept { return size_ == 0; }
+  size_type capacity() const noexcept { return generations_.size(); }
+
+ private:
+  using SlabAllocator = AllocatorWrapper<T, Alloc>;
+  static constexpr uint32_t kNoSlot = 0xffffffffu; // end of free list
+  static constexpr uint32_t kLive = 0xfffffffeu;   // nextfree_ of a live slot
+  static constexpr uint32_t kRetired = 0xfffffffdu; // nextfree_ of a slot out of generations
+
+  // bump the generation of a slot whose object was destroyed
+  // true when it has no generation left, the slot is then never reused
+  bool Retire(uint32_t slot) noexcept {
+    if (generations_[slot] == kObjectGenerationMask) {
+      nextfree_[slot] = kRetired;
+      return true;
+    }
+    ++generations_[slot];
+    return false;
+  }
+  T* Address(uint32_t slot) const noexcept {
+    return slabs_[slot / kSlabObjects] + slot % kSlabObjects;
+  }
+  // total order of pointers into different slabs, where < is unspecified
+  static bool Before(const T* a, const T* b) noexcept { return std::less<const T*>()(a, b); }
+  // binary search of the slab holding p, kNoSlot when no slab does
+  uint32_t SlotOf(const T* p) const noexcept {
+    if (sorted_.empty()) { return kNoSlot; }
+    size_type lo = 0, hi = sorted_.size();
+    while (hi - lo > 1) {
+      size_type mid = (lo + hi) / 2;
+      if (!Before(p, sorted_[mid].begin)) { lo = mid; }
+      else { hi = mid; }
+    }
+    const SlabRange& range = sorted_[lo];
+    if (Before(p, range.begin) || !Before(p, range.begin + kSlabObjects)) { return kNoSlot; }
+    return static_cast<uint32_t>(range.slab * kSlabObjects + (p - range.begin));
+  }
+  template<class... Args>
+  uint32_t CreateSlot(Args&&... args) {
+    if (freehead_ == kNoSlot) { NewSlab(); }
+    const uint32_t slot = freehead_;
+    easystl::Construct(Address(slot), std::forward<Args>(args)...);
+    freehead_ = nextfree_[slot];
+    nextfree_[slot] = kLive;
+    ++size_;
+    return slot;
+  }
+  void DestroySlot(uint32_t slot) {
+    easystl::Destroy(Address(slot));
+    --size_;
+    if (Retire(slot)) { return; }
+    nextfree_[slot] = freehead_;
+    freehead_ = slot;
+  }
+  // a new slab, its slots are pushed so the lowest comes out first
+  void NewSlab() {
+    const size_type first = generations_.size();
+    if (first + kSlabObjects > size_type(kObjectIndexMask) + 1) {
+      throw std::length_error("ObjectPool: slot index no longer fits in a handle");
+    }
+    T* slab = SlabAllocator::Allocate(kSlabObjects);
+    const uint32_t slabindex = static_cast<uint32_t>(slabs_.size());
+    slabs_.push_back(slab);
+    // first range above slab, slabs mostly come in address order
+    size_type pos = sorted_.size();
+    if (pos > 0 && Before(slab, sorted_[pos - 1].begin)) {
+      size_type lo = 0, hi = pos;
+      while (lo < hi) {
+        size_type mid = (lo + hi) / 2;
+        if (Before(sorted_[mid].begin, slab)) { lo = mid + 1; }
+        else { hi = mid; }
+      }
+      pos = lo;
+    }
+    SlabRange range = { slab, slabindex };
+    sorted_.insert(sorted_.begin() + pos, 1, range);
+    generations_.resize(first + kSlabObjects, 1);
+    nextfree_.resize(first + kSlabObjects, kNoSlot);
+    for (size_type i = first + kSlabObjects; i > first; --i) {
+      nextfree_[i - 1] = freehead_;
+      freehead_ = static_cast<uint32_t>(i - 1);
+    }
+  }
+
+  struct SlabRange {
+    T* begin;
+    uint32_t slab;
+  };
+
+  vector<T*> slabs_;              // slab i holds slots [i * kSlabObjects, (i + 1) * kSlabObjects)
+  vector<SlabRange> sorted_;      // slabs by address, for pointer -> slot
+  vector<uint32_t> generations_;  // per slot
+  vector<uint32_t> nextfree_;     // per slot, free list link or kLive
+  uint32_t freehead_;
+  size_type size_;
+};
+
+} // namespace easystl
+
+#endif // EASYSTL_OBJECT_POOL_H_
@@ -0,0 +1,301 @@
+#ifndef EASYSTL_STABLE_VECTOR_H_
+#define EASYSTL_STABLE_VECTOR_H_
+
+#include <initializer_list>
+#include "allocator.h"
+#include "constructor.h"
+#include "iterator.h"
+#include "algo.h"
+
+namespace easystl {
+
+// segmented vector
+// elements live in blocks whose sizes grow geometrically:
+// block k holds kBlockBase << k elements, so block k starts at
+// index kBlockBase * (2^k - 1). the block map is a fixed size
+// array allocated with the first element, so growing never moves
+// an element and never copies the map, and swap only exchanges
+// the map pointers: iterators keep following their elements.
+// push_back is O(1) in the worst case (one allocation, no copy)
+// and the address of an element is stable until it is popped.
+// iterators taken before the first push_back have no map yet and
+// are invalidated by it.
+static constexpr size_t kStableVectorBlockBase = 16;
+static constexpr size_t kStableVectorMaxBlocks = 48;
+
+// index helpers shared by stable_vector and its iterator
+class StableVectorIndex {
+ public:
+  static size_t BlockOf(size_t i) {
+    size_t j = i / kStableVectorBlockBase + 1;
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<size_t>(63 - __builtin_clzll(static_cast<unsigned long long>(j)));
+#else
+    size_t k = 0;
+    while (j >>= 1) { ++k; }
+    return k;
+#endif
+  }
+  static size_t BlockStart(size_t k) { return kStableVectorBlockBase * ((size_t(1) << k) - 1); }
+  static size_t BlockSize(size_t k) { return kStableVectorBlockBase << k; }
+};
+
+template<class T, class Ref, class Ptr>
+class StableVectorIterator : public Iterator<RandomAccessIteratorTag, T, ptrdiff_t, Ptr, Ref> {
+ public:
+  using Self = StableVectorIterator<T, Ref, Ptr>;
+  using size_type = size_t;
+  using difference_type = ptrdiff_t;
+
+  StableVectorIterator() noexcept
+    : blocks_(nullptr), index_(0), cur_(nullptr), first_(nullptr), last_(nullptr) {}
+  StableVectorIterator(T* const* blocks, size_type index) noexcept
+    : blocks_(blocks) { SetIndex(index); }
+  // iterator -> const_iterator, never the other way
+  template<class R, class P, typename std::enable_if_t<
+    std::is_same<R, T&>::value && std::is_same<P, T*>::value, int> = 0>
+  StableVectorIterator(const StableVectorIterator<T, R, P>& other) noexcept
+    : blocks_(other.blocks_), index_(other.index_), cur_(other.cur_),
+      first_(other.first_), last_(other.last_) {}
+
+  Ref operator*() const noexcept { return *cur_; }
+  Ptr operator->() const noexcept { return cur_; }
+  Ref operator[](difference_type n) const noexcept { return *(*this + n); }
+
+  Self& operator++() noexcept {
+    ++index_;
+    if (++cur_ == last_) { SetIndex(index_); }
+    return *this;
+  }
+  Self operator++(int) noexcept {
+    Self tmp = *this;
+    ++*this;
+    return tmp;
+  }
+  Self& operator--() noexcept {
+    --index_;
+    if (cur_ == first_) { SetIndex(index_); }
+    else { --cur_; }
+    return *this;
+  }
+  Self operator--(int) noexcept {
+    Self tmp = *this;
+    --*this;
+    return tmp;
+  }
+  Self& operator+=(difference_type n) noexcept {
+    const difference_type offset = (cur_ - first_) + n;
+    index_ += n;
+    // stay inside the current block when we can
+    if (first_ && offset >= 0 && offset < last_ - first_) { cur_ = first_ + offset; }
+    else { SetIndex(index_); }
+    return *this;
+  }
+  Self& operator-=(difference_type n) noexcept { return *this += -n; }
+  Self operator+(difference_type n) const noexcept {
+    Self tmp = *this;
+    return tmp += n;
+  }
+  Self operator-(difference_type n) const noexcept {
+    Self tmp = *this;
+    return tmp -= n;
+  }
+  difference_type operator-(const Self& rhs) const noexcept {
+    return static_cast<difference_type>(index_) - static_cast<difference_type>(rhs.index_);
+  }
+
+  bool operator==(const Self& rhs) const noexcept { return blocks_ == rhs.blocks_ && index_ == rhs.index_; }
+  bool operator!=(const Self& rhs) const noexcept { return !(*this == rhs); }
+  bool operator<(const Self& rhs) const noexcept { return index_ < rhs.index_; }
+  bool operator>(const Self& rhs) const noexcept { return rhs < *this; }
+  bool operator<=(const Self& rhs) const noexcept { return !(rhs < *this); }
+  bool operator>=(const Self& rhs) const noexcept { return !(*this < rhs); }
+
+ private:
+  template<class U, class R, class P> friend class StableVectorIterator;
+
+  // locate the block holding index i
+  // blocks that are not allocated yet give a null position,
+  // which is only ever compared, never dereferenced
+  void SetIndex(size_type i) noexcept {
+    index_ = i;
+    const size_type k = StableVectorIndex::BlockOf(i);
+    first_ = blocks_ && k < kStableVectorMaxBlocks ? blocks_[k] : nullptr;
+    if (first_) {
+      cur_ = first_ + (i - StableVectorIndex::BlockStart(k));
+      last_ = first_ + StableVectorIndex::BlockSize(k);
+    }
+    else {
+      cur_ = last_ = nullptr;
+    }
+  }
+
+  T* const* blocks_; // block map of the owning stable_vector
+  size_type index_;  // global index
+  T* cur_;           // current element
+  T* first_;         // head of current block
+  T* last_;          // tail of current block
+};
+
+template<class T, class Alloc = Allo>
+class stable_vector {
+ public:
+  // type alias
+  using value_type      = T;
+  using pointer         = T*;
+  using reference       = T&;
+  using const_reference = const T&;
+  using iterator        = StableVectorIterator<T, T&, T*>;
+  using const_iterator  = StableVectorIterator<T, const T&, const T*>;
+  using size_type       = size_t;
+  using difference_type = ptrdiff_t;
+  // constructor
+  stable_vector() noexcept : blocks_(nullptr), size_(0), blocknums_(0) {}
+  stable_vector(size_type len, const T& value) : blocks_(nullptr), size_(0), blocknums_(0) {
+    try {
+      for (; len > 0; --len) { push_back(value); }
+    }
+    catch(...) {
+      DestroynDeallocate();
+      throw;
+    }
+  }
+  explicit stable_vector(size_type len) : stable_vector(len, T()) {}
+  template<class Iter, typename std::enable_if_t<IsIterator<Iter>::value, int> = 0>
+  stable_vector(Iter first, Iter last) : blocks_(nullptr), size_(0), blocknums_(0) {
+    try {
+      for (; first != last; ++first) { push_back(*first); }
+    }
+    catch(...) {
+      DestroynDeallocate();
+      throw;
+    }
+  }
+  stable_vector(std::initializer_list<value_type> ilist)
+    : stable_vector(ilist.begin(), ilist.end()) {}
+  // copy constructor
+  stable_vector(const stable_vector& other) : blocks_(nullptr), size_(0), blocknums_(0) {
+    try {
+      other.for_each_segment([this](const T* first, const T* last) {
+        for (; first != last; ++first) { push_back(*first); }
+      });
+    }
+    catch(...) {
+      DestroynDeallocate();
+      throw;
+    }
+  }
+  // copy assignment operator
+  // copy and swap, *this is unchanged if a copy throws
+  stable_vector& operator=(const stable_vector& rhs) {
+    if (this != &rhs) {
+      stable_vector tmp(rhs);
+      swap(tmp);
+    }
+    return *this;
+  }
+  // destructor
+  ~stable_vector() noexcept { DestroynDeallocate(); }
+  // basic operation
+  iterator begin() noexcept { return iterator(blocks_, 0); }
+  iterator end() noexcept { return iterator(blocks_, size_); }
+  const_iterator begin() const noexcept { return const_iterator(blocks_, 0); }
+  const_iterator end() const noexcept { return const_iterator(blocks_, size_); }
+  size_type size() const noexcept { return size_; }
+  bool empty() const noexcept { return size_ == 0; }
+  size_type capacity() const noexcept { return StableVectorIndex::BlockStart(blocknums_); }
+  reference operator[](size_type n) noexcept { return *Address(n); }
+  const_reference operator[](size_type n) const noexcept { return *Address(n); }
+  reference front() noexcept { return *blocks_[0]; }
+  reference back() noexcept { return *Address(size_ - 1); }
+  // a throwing copy leaves the size unchanged,
+  // a block allocated for it is kept for the next push_back
+  void push_back(const T& x) {
+    if (nullptr == blocks_) { NewMap(); }
+    const size_type k = StableVectorIndex::BlockOf(size_);
+    if (k == blocknums_) {
+      // new block appended to the map, nothing is moved
+      blocks_[k] = DataAllocator::Allocate(StableVectorIndex::BlockSize(k));
+      ++blocknums_;
+    }
+    Construct(blocks_[k] + (size_ - StableVectorIndex::BlockStart(k)), x);
+    ++size_;
+  }
+  void pop_back() noexcept {
+    if (empty()) { return; }
+    --size_;
+    Destroy(Address(size_));
+  }
+  // blocks are kept for reuse, only elements are destroyed
+  void clear() noexcept {
+    for_each_segment([](T* first, T* last) { Destroy(first, last); });
+    size_ = 0;
+  }
+  void swap(stable_vector& rhs) noexcept {
+    if (this != &rhs) {
+      easystl::Swap(blocks_, rhs.blocks_);
+      easystl::Swap(size_, rhs.size_);
+      easystl::Swap(blocknums_, rhs.blocknums_);
+    }
+  }
+  // block-wise iteration
+  // every used block is a contiguous array, so algorithms can
+  // work on raw pointers for each segment
+  size_type segment_count() const noexcept {
+    return size_ == 0 ? 0 : StableVectorIndex::BlockOf(size_ - 1) + 1;
+  }
+  pointer segment_begin(size_type k) noexcept { return blocks_[k]; }
+  pointer segment_end(size_type k) noexcept { return blocks_[k] + SegmentSize(k); }
+  // func is called as func(first, last) for each used block in order
+  template<class Func>
+  void for_each_segment(Func func) {
+    const size_type count = segment_count();
+    for (size_type k = 0; k < count; ++k) {
+      func(blocks_[k], blocks_[k] + SegmentSize(k));
+    }
+  }
+  template<class Func>
+  void for_each_segment(Func func) const {
+    const size_type count = segment_count();
+    for (size_type k = 0; k < count; ++k) {
+      func(static_cast<const T*>(blocks_[k]), static_cast<const T*>(blocks_[k] + SegmentSize(k)));
+    }
+  }
+
+ private:
+  // allocator
+  using DataAllocator = AllocatorWrapper<T, Alloc>;
+  using MapAllocator = AllocatorWrapper<T*, Alloc>;
+  void NewMap() {
+    blocks_ = MapAllocator::Allocate(kStableVectorMaxBlocks);
+    for (size_type k = 0; k < kStableVectorMaxBlocks; ++k) { blocks_[k] = nullptr; }
+  }
+  // destroy elements and release every block and the map
+  void DestroynDeallocate() noexcept {
+    clear();
+    for (size_type k = 0; k < blocknums_; ++k) {
+      DataAllocator::Deallocate(blocks_[k], StableVectorIndex::BlockSize(k));
+    }
+    if (blocks_) { MapAllocator::Deallocate(blocks_, kStableVectorMaxBlocks); }
+    blocks_ = nullptr;
+    blocknums_ = 0;
+  }
+  T* Address(size_type n) const noexcept {
+    const size_type k = StableVectorIndex::BlockOf(n);
+    return blocks_[k] + (n - StableVectorIndex::BlockStart(k));
+  }
+  // used elements of block k
+  size_type SegmentSize(size_type k) const noexcept {
+    const size_type start = StableVectorIndex::BlockStart(k);
+    const size_type len = StableVectorIndex::BlockSize(k);
+    return size_ - start < len ? size_ - start : len;
+  }
+
+  T** blocks_;                        // block map, kStableVectorMaxBlocks entries
+  size_type size_;                    // used elements
+  size_type blocknums_;               // allocated blocks
+};
+
+} // namespace easystl
+
+#endif // EASYSTL_STABLE_VECTOR_H_
@@ -0,0 +1,220 @@
+#ifndef EASYSTL_THREAD_CACHE_H_
+#define EASYSTL_THREAD_CACHE_H_
+
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include "allocator.h"
+
+namespace easystl {
+
+// thread caching memory pool
+// every thread owns a set of free lists like MemoryPoolAllocator,
+// so allocation and local frees take no lock. small blocks are
+// carved from kThreadCacheChunkBytes aligned chunks whose header names the
+// owning cache, so a block freed on another thread is found to be
+// remote and pushed onto the owner's lock-free return list instead
+// of staying in the freeing thread's cache forever. the owner takes
+// the whole return list in one exchange the next time a free list
+// runs empty and reuses it before carving new memory.
+static constexpr size_t kThreadCacheChunkBytes = size_t(1) << 16;
+static constexpr size_t kThreadCacheChunkHeader = 64;
+static constexpr int kThreadCacheRefillNums = 20;
+
+class ThreadCache {
+ public:
+  ThreadCache() : freespacestart_(nullptr), freespaceend_(nullptr), next_(nullptr) {
+    for (int i = 0; i < kFreeListNum; ++i) { remote_[i].store(nullptr, std::memory_order_relaxed); }
+  }
+  // both called by the owning thread only
+  void* Allocate(size_t index) {
+    if (freelist_[index].Empty()) { return ReFill(index); }
+    return freelist_[index].Pop();
+  }
+  void DeallocateLocal(void *obj, size_t index) { freelist_[index].Push(obj); }
+  // any thread, lock free push onto the return list
+  void DeallocateRemote(void *obj, size_t index) {
+    void *head = remote_[index].load(std::memory_order_relaxed);
+    do {
+      *static_cast<void**>(obj) = head;
+    } while (!remote_[index].compare_exchange_weak(head, obj, std::memory_order_release,
+                                                   std::memory_order_relaxed));
+  }
+
+ private:
+  friend class ThreadCacheAllocator;
+
+  static size_t BlockSize(size_t index) { return (index + 1) * kAlign; }
+  // return list first, a new batch from the chunk otherwise
+  void* ReFill(size_t index) {
+    void *list = remote_[index].exchange(nullptr, std::memory_order_acquire);
+    if (list) {
+      void *result = list;
+      list = *static_cast<void**>(list);
+      while (list) {
+        void *next = *static_cast<void**>(list);
+        freelist_[index].Push(list);
+        list = next;
+      }
+      return result;
+    }
+    const size_t size = BlockSize(index);
+    if (size_t(freespaceend_ - freespacestart_) < size) { NewChunk(); }
+    size_t nums = size_t(freespaceend_ - freespacestart_) / size;
+    if (nums > size_t(kThreadCacheRefillNums)) { nums = kThreadCacheRefillNums; }
+    char *result = freespacestart_;
+    freespacestart_ += nums * size;
+    for (char *p = result + size; p != freespacestart_; p += size) {
+      freelist_[index].Push(p);
+    }
+    return result;
+  }
+  void NewChunk();
+
+  MemoryPoolList freelist_[kFreeListNum];
+  std::atomic<void*> remote_[kFreeListNum]; // blocks freed by other threads
+  char *freespacestart_;
+  char *freespaceend_;
+  ThreadCache *next_; // orphan list link
+};
+
+// allocator interface over the per-thread caches
+class ThreadCacheAllocator {
+ public:
+  static void* Allocate(size_t size) {
+    if (size > size_t(kMaxBytes)) { return MallocAllocator::Allocate(size); }
+    ThreadCache *local = Local();
+    if (nullptr == local) { return AllocateDetached(GetFreelistIndex(size)); }
+    return local->Allocate(GetFreelistIndex(size));
+  }
+  static void Deallocate(void *obj, size_t size) {
+    if (size > size_t(kMaxBytes)) {
+      MallocAllocator::Deallocate(obj, size);
+      return ;
+    }
+    // a thread whose cache is gone frees every block remotely
+    ThreadCache *owner = OwnerOf(obj);
+    ThreadCache *local = Local();
+    if (owner == local) { local->DeallocateLocal(obj, GetFreelistIndex(size)); }
+    else { owner->DeallocateRemote(obj, GetFreelistIndex(size)); }
+  }
+  static void* Reallocate(void *obj, size_t oldsize, size_t newsize) {
+    if (nullptr == obj) { return Allocate(newsize); }
+    if (oldsize > size_t(kMaxBytes) && newsize > size_t(kMaxBytes)) {
+      return MallocAllocator::Reallocate(obj, oldsize, newsize);
+    }
+    if (oldsize <= size_t(kMaxBytes) && newsize <= size_t(kMaxBytes) &&
+        GetFreelistIndex(oldsize) == GetFreelistIndex(newsize)) {
+      return obj;
+    }
+    void *result = Allocate(newsize);
+    std::memcpy(result, obj, oldsize < newsize ? oldsize : newsize);
+    Deallocate(obj, oldsize);
+    return result;
+  }
+  // bytes of chunks taken from the system by all caches
+  static size_t ChunkBytes() { return chunkbytes_.load(std::memory_order_relaxed); }
+
+ private:
+  friend class ThreadCache;
+
+  static size_t GetFreelistIndex(size_t bytes) { return ((bytes + kAlign - 1)/kAlign -1); }
+  static ThreadCache* OwnerOf(void *obj) {
+    uintptr_t chunk = reinterpret_cast<uintptr_t>(obj) & ~uintptr_t(kThreadCacheChunkBytes - 1);
+    return *reinterpret_cast<ThreadCache**>(chunk);
+  }
+
+  // a cache outlives its thread: blocks it handed out may still be
+  // freed remotely, so on thread exit it is parked on the orphan
+  // list and adopted by the next thread that needs a cache. the
+  // pointer itself is a trivially destructible thread_local, so
+  // later thread_local or static destructors can still read it;
+  // the guard only orphans the cache and clears the pointer, after
+  // which the thread sees no local cache and never touches one
+  // another thread may have adopted
+  class LocalGuard {
+   public:
+    LocalGuard() { localcache_ = Adopt(); }
+    ~LocalGuard() {
+      ThreadCache *cache = localcache_;
+      localcache_ = nullptr;
+      localexited_ = true;
+      Orphan(cache);
+    }
+  };
+  static ThreadCache* Local() {
+    if (nullptr == localcache_ && !localexited_) {
+      static thread_local LocalGuard guard;
+    }
+    return localcache_;
+  }
+  static ThreadCache* Adopt();
+  static void Orphan(ThreadCache *cache);
+  // no local cache any more: borrow one for a single allocation
+  static void* AllocateDetached(size_t index) {
+    ThreadCache *cache = Adopt();
+    void *result = cache->Allocate(index);
+    Orphan(cache);
+    return result;
+  }
+
+  static thread_local ThreadCache *localcache_;
+  static thread_local bool localexited_;
+  static std::mutex orphanlock_;
+  static ThreadCache *orphans_;
+  static std::atomic<size_t> chunkbytes_;
+};
+
+thread_local ThreadCache *ThreadCacheAllocator::localcache_ = nullptr;
+thread_local bool ThreadCacheAllocator::localexited_ = false;
+std::mutex ThreadCacheAllocator::orphanlock_;
+ThreadCache *ThreadCacheAllocator::orphans_ = nullptr;
+std::atomic<size_t> ThreadCacheAllocator::chunkbytes_(0);
+
+ThreadCache* ThreadCacheAllocator::Adopt() {
+  {
+    std::lock_guard<std::mutex> lock(orphanlock_);
+    if (orphans_) {
+      ThreadCache *cache = orphans_;
+      orphans_ = cache->next_;
+      cache->next_ = nullptr;
+      return cache;
+    }
+  }
+  return new ThreadCache();
+}
+
+// caches that own memory go first, so the next allocating thread
+// picks up their free and return lists instead of a new chunk
+void ThreadCacheAllocator::Orphan(ThreadCache *cache) {
+  std::lock_guard<std::mutex> lock(orphanlock_);
+  ThreadCache **link = &orphans_;
+  if (nullptr == cache->freespaceend_) {
+    while (*link) { link = &(*link)->next_; }
+  }
+  cache->next_ = *link;
+  *link = cache;
+}
+
+// the rest of the old chunk is given to the free lists,
+// the new chunk starts with a pointer to its owner
+void ThreadCache::NewChunk() {
+  size_t left = size_t(freespaceend_ - freespacestart_);
+  if (left >= size_t(kAlign)) {
+    freelist_[ThreadCacheAllocator::GetFreelistIndex(left)].Push(freespacestart_);
+  }
+  void *chunk = nullptr;
+  if (posix_memalign(&chunk, kThreadCacheChunkBytes, kThreadCacheChunkBytes) != 0) {
+    std::abort();
+  }
+  *static_cast<ThreadCache**>(chunk) = this;
+  ThreadCacheAllocator::chunkbytes_.fetch_add(kThreadCacheChunkBytes, std::memory_order_relaxed);
+  freespacestart_ = static_cast<char*>(chunk) + kThreadCacheChunkHeader;
+  freespaceend_ = static_cast<char*>(chunk) + kThreadCacheChunkBytes;
+}
+
+} // namespace easystl
+
+#endif // EASYSTL_THREAD_CACHE_H_
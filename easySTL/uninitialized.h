@@ -1,13 +1,15 @@
 #ifndef EASYSTL_UNINITIALIZED_H_
 #define EASYSTL_UNINITIALIZED_H_
 
-#include <cstdlib>
+#include <cstring>
 #include "constructor.h"
+#include "iterator.h"
 // helper funcs to construct value in uninitialized place which is already allocated
+// if a constructor throws, what was built so far is destroyed and the exception is rethrown
 namespace easystl {
 
 template <class InputIter, class ForwardIter>
-ForwardIter uninitialized_copy(InputIter first, InputIter last, ForwardIter result) {
+ForwardIter __uninitialized_copy(InputIter first, InputIter last, ForwardIter result, FalseType) {
   auto current = result;
   try {
     for(; first != last; ++first, ++current) {
@@ -16,13 +18,28 @@ ForwardIter uninitialized_copy(InputIter first, InputIter last, ForwardIter resu
   }
   catch(...) {
     easystl::Destroy(result, current);
-    std::abort();
+    throw;
   }
   return current;
 }
 
+// trivially copyable objects can be created by copying their bytes
+template <class InputIter, class ForwardIter>
+ForwardIter __uninitialized_copy(InputIter first, InputIter last, ForwardIter result, TrueType) {
+  const auto n = last - first;
+  if (n > 0) {
+    std::memmove(ToAddress(result), ToAddress(first), static_cast<size_t>(n) * sizeof(*ToAddress(first)));
+  }
+  return result + n;
+}
+
+template <class InputIter, class ForwardIter>
+ForwardIter uninitialized_copy(InputIter first, InputIter last, ForwardIter result) {
+  return __uninitialized_copy(first, last, result, IsMemCopyable<InputIter, ForwardIter>());
+}
+
 template <class ForwardIter, class T>
-void uninitialized_fill(ForwardIter first, ForwardIter last, const T& value) {
+void __uninitialized_fill(ForwardIter first, ForwardIter last, const T& value, FalseType) {
   auto current = first;
   try {
     for(; current != last; ++current) {
@@ -31,12 +48,25 @@ void uninitialized_fill(ForwardIter first, ForwardIter last, const T& value) {
   }
   catch(...) {
     easystl::Destroy(first, current);
-    std::abort();
+    throw;
   }
 }
 
+template <class ForwardIter, class T>
+void __uninitialized_fill(ForwardIter first, ForwardIter last, const T& value, TrueType) {
+  const auto n = last - first;
+  if (n <= 0) { return; }
+  const T tmp = value;
+  for (auto p = ToAddress(first), end = p + n; p != end; ++p) { easystl::Construct(p, tmp); }
+}
+
+template <class ForwardIter, class T>
+void uninitialized_fill(ForwardIter first, ForwardIter last, const T& value) {
+  __uninitialized_fill(first, last, value, IsMemFillable<ForwardIter, T>());
+}
+
 template <class ForwardIter, class Size, class T>
-ForwardIter uninitialized_fill_n(ForwardIter first, Size n, const T& value) {
+ForwardIter __uninitialized_fill_n(ForwardIter first, Size n, const T& value, FalseType) {
   auto current = first;
   try {
     for(; n > 0; --n, ++current) {
@@ -45,11 +75,23 @@ ForwardIter uninitialized_fill_n(ForwardIter first, Size n, const T& value) {
   }
   catch(...) {
     easystl::Destroy(first, current);
-    std::abort();
+    throw;
   }
   return current;
 }
 
+template <class ForwardIter, class Size, class T>
+ForwardIter __uninitialized_fill_n(ForwardIter first, Size n, const T& value, TrueType) {
+  if (n <= 0) { return first; }
+  __uninitialized_fill(first, first + n, value, TrueType());
+  return first + n;
+}
+
+template <class ForwardIter, class Size, class T>
+ForwardIter uninitialized_fill_n(ForwardIter first, Size n, const T& value) {
+  return __uninitialized_fill_n(first, n, value, IsMemFillable<ForwardIter, T>());
+}
+
 } // namespace easystl
 
 #endif // EASYSTL_UNINITIALIZED_H_
\ No newline at end of file
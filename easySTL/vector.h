@@ -16,15 +16,24 @@ class vector {
   using value_type      = T;
   using pointer         = T*;
   using iterator        = T*;
+  using const_iterator  = const T*;
   using reference       = T&;
+  using const_reference = const T&;
   using size_type       = size_t;
   using difference_type = ptrdiff_t;
+  // copying elements cannot throw
+  // every member that only copies T is noexcept for such types,
+  // others get the strong guarantee on growth and rethrow
+  static constexpr bool kNothrowCopy = std::is_nothrow_copy_constructible<T>::value &&
+                                       std::is_nothrow_copy_assignable<T>::value;
+  // same, for members that also build a T()
+  static constexpr bool kNothrowDefault = kNothrowCopy && std::is_nothrow_default_constructible<T>::value;
   // constructor
   vector() noexcept : begin_(nullptr), end_(nullptr), capacity_(nullptr) {}
-  vector(size_type len, const T& value) noexcept { NumsInit(len, value); }
-  explicit vector(size_type len) noexcept { NumsInit(len, T()); }
+  vector(size_type len, const T& value) noexcept(kNothrowCopy) { NumsInit(len, value); }
+  explicit vector(size_type len) noexcept(kNothrowDefault) { NumsInit(len, T()); }
   template<class Iterator, typename std::enable_if_t<IsIterator<Iterator>::value, int> = 0>
-  vector(Iterator first, Iterator last) noexcept {
+  vector(Iterator first, Iterator last) {
     RangeInit(first, last);
   }
 
@@ -32,11 +41,11 @@ class vector {
     RangeInit(ilist.begin(), ilist.end());
   }
   // copy constructor
-  vector(const vector& other) noexcept {
+  vector(const vector& other) noexcept(kNothrowCopy) {
     RangeInit(other.begin_, other.end_);
   }
   // copy assignment operator
-  vector& operator=(const vector& rhs) noexcept {
+  vector& operator=(const vector& rhs) noexcept(kNothrowCopy) {
     if(this != &rhs) {
       const size_type rhslen = rhs.size();
       if(rhslen > capacity()) {
@@ -49,15 +58,15 @@ class vector {
         end_ = begin_ + rhslen;
       }
       else {
-        Copy(rhs.begin_, rhs.end_, begin_);
-        uninitialized_copy(rhs.begin_ + size(), rhs.end_, end_);
+        Copy(rhs.begin_, rhs.begin_ + size(), begin_);
+        easystl::uninitialized_copy(rhs.begin_ + size(), rhs.end_, end_);
         end_ = begin_ + rhslen;
       }  
     }
     return *this;
   }
-  vector& operator=(std::initializer_list<value_type> ilist) noexcept {
-    vector<T> tmp(ilist);
+  vector& operator=(std::initializer_list<value_type> ilist) noexcept(kNothrowCopy) {
+    vector tmp(ilist);
     swap(tmp);
     return *this;
   }
@@ -66,13 +75,16 @@ class vector {
   // basic operation
   iterator begin() noexcept { return begin_; }
   iterator end() noexcept { return end_; }
+  const_iterator begin() const noexcept { return begin_; }
+  const_iterator end() const noexcept { return end_; }
   size_type size() const noexcept { return static_cast<size_type>(end_ - begin_); }
   bool empty() const noexcept { return begin_ == end_; }
   size_type capacity() const noexcept { return static_cast<size_type>(capacity_ - begin_); }
   reference operator[] (size_type n) noexcept { return *(begin_ + n); }
+  const_reference operator[] (size_type n) const noexcept { return *(begin_ + n); }
   reference front() noexcept { return *begin(); }
   reference back()noexcept { return *(end_ - 1); }
-  void push_back(const T& x) noexcept {
+  void push_back(const T& x) noexcept(kNothrowCopy) {
     if(end_ != capacity_) {
       Construct(end_, x);
       ++end_;
@@ -86,21 +98,21 @@ class vector {
     --end_;
     Destroy(end_);
   }
-  iterator erase(iterator pos) noexcept {
+  iterator erase(iterator pos) noexcept(kNothrowCopy) {
     Copy(pos + 1, end_, pos); 
-    Destroy(end_);
     --end_;
+    Destroy(end_);
     return pos;
   }
-  iterator erase(iterator first, iterator last) noexcept {
+  iterator erase(iterator first, iterator last) noexcept(kNothrowCopy) {
     if(first!=last) {
       auto i = Copy(last, end_, first);
       Destroy(i, end_);
       end_ = end_ - static_cast<size_type>(last - first);
     }
-    return last;
+    return first;
   }
-  void resize(size_type newsize, const T& x) noexcept {
+  void resize(size_type newsize, const T& x) noexcept(kNothrowCopy) {
     if(newsize < size()) {
       erase(begin_ + newsize, end_);
     }
@@ -108,7 +120,11 @@ class vector {
       insert(end_, newsize - size(), x);
     }
   }
-  void resize(size_type newsize) noexcept { resize(newsize, T()); }
+  void resize(size_type newsize) noexcept(kNothrowDefault) { resize(newsize, T()); }
+  // capacity for at least n elements, a throwing copy leaves *this untouched
+  void reserve(size_type n) {
+    if(n > capacity()) { ReserveAux(n, IsTriviallyCopyable<T>()); }
+  }
   void clear() noexcept { erase(begin_, end_); }
   pointer data() noexcept { return begin_; }
   // swap vector
@@ -120,78 +136,88 @@ class vector {
     }
   }
   // insert
-  iterator insert(iterator pos, size_type size, const T& x) noexcept {
+  iterator insert(iterator pos, size_type size, const T& x) noexcept(kNothrowCopy) {
+    const size_type offset = static_cast<size_type>(pos - begin_);
     // leftbytes enough
     if(size_type(capacity_ -  end_) >= size) {
+      const T value = x; // x may be an element that is about to move
       const size_type elemsafter = end_ - pos;
       iterator oldend = end_;
       if(elemsafter > size) {
-        uninitialized_copy(end_ - size, end_, end_);
+        easystl::uninitialized_copy(end_ - size, end_, end_);
         end_ += size;
         Copybackward(pos, oldend - size, oldend);
-        Fill(pos, pos + size, x);
+        Fill(pos, pos + size, value);
       }
       else {
-        uninitialized_fill_n(end_, size - elemsafter, x);
+        easystl::uninitialized_fill_n(end_, size - elemsafter, value);
         end_ += size - elemsafter;
-        uninitialized_copy(pos, oldend, end_);
+        easystl::uninitialized_copy(pos, oldend, end_);
         end_ += elemsafter;
-        Fill(pos, oldend, x);
+        Fill(pos, oldend, value);
       }
     }
     // leftbytes not enough
     else {
       InsertAux(pos, size, x);
     }
-    return pos;
+    return begin_ + offset;
   }
   
   template<class Iter1, class Iter2,
     typename std::enable_if_t<IsIterator<Iter1>::value, int> = 0, 
     typename std::enable_if_t<IsIterator<Iter2>::value, int> = 0>
-  iterator insert(Iter1 pos, Iter2 first, Iter2 last) noexcept {
+  iterator insert(Iter1 pos, Iter2 first, Iter2 last) {
     if (first == last) return pos;
-    const auto size = last - first;
+    const size_type offset = static_cast<size_type>(pos - begin_);
+    const size_type size = static_cast<size_type>(Distance(first, last));
     // leftbytes enough
     if (size_type(capacity_ - end_) >= size) {
       const size_type elemsafter = end_ - pos;
       iterator oldend = end_;
       if (elemsafter > size) {
-        uninitialized_copy(end_ - size, end_, end_);
+        easystl::uninitialized_copy(end_ - size, end_, end_);
         end_ += size;
         Copybackward(pos, oldend - size, oldend);
         Copy(first, last, pos);
       }
       else {
-        uninitialized_fill_n(end_, size - elemsafter, T());
-        end_ += size - elemsafter;
-        uninitialized_copy(pos, oldend, end_);
-        end_ += elemsafter;
-        Copy(first, last, pos);
+        // the tail of [first, last) lands in raw memory after end_
+        Iter2 mid = first;
+        Advance(mid, elemsafter);
+        end_ = easystl::uninitialized_copy(mid, last, end_);
+        end_ = easystl::uninitialized_copy(pos, oldend, end_);
+        Copy(first, mid, pos);
       }
     }
     // leftbytes not enough
     else {
       InsertAux(pos, first, last);
     }
+    return begin_ + offset;
   }
-  iterator insert(iterator pos, const T& x) noexcept {
+  iterator insert(iterator pos, const T& x) noexcept(kNothrowCopy) {
     return insert(pos, 1, x);
   }
   // assign
-  void assign(size_type n, const T& value) noexcept {
-    clear();
+  // value may be one of our elements, so nothing is
+  // destroyed before the last read of it
+  void assign(size_type n, const T& value) noexcept(kNothrowCopy) {
     if (n > capacity()) {
       vector tmp(n, value);
       swap(tmp);
     }
+    else if (n > size()) {
+      Fill(begin_, end_, value);
+      end_ = easystl::uninitialized_fill_n(end_, n - size(), value);
+    }
     else {
-      uninitialized_fill_n(begin_, n, value);
-      end_ = begin_ + n;
+      Fill(begin_, begin_ + n, value);
+      erase(begin_ + n, end_);
     }
   }
   template<class Iter, typename std::enable_if_t<IsIterator<Iter>::value, int> = 0>
-  void assign(Iter first, Iter last) noexcept {
+  void assign(Iter first, Iter last) {
     clear();
     const size_type len = last - first;
     if (len > capacity()) {
@@ -199,11 +225,11 @@ class vector {
       swap(tmp);
     }
     else {
-      uninitialized_copy(first, last, begin_);
+      easystl::uninitialized_copy(first, last, begin_);
       end_ = begin_ + len;
     }
   }
-  void assign(std::initializer_list<value_type> ilist) noexcept {
+  void assign(std::initializer_list<value_type> ilist) noexcept(kNothrowCopy) {
     assign(ilist.begin(), ilist.end());
   }
  private:
@@ -213,19 +239,34 @@ class vector {
   // memory size is n * sizeof(T)
   // construct n variables of type T with values of value
   // initialize
-  void NumsInit(size_type n, const T& value) noexcept {
+  // the constructor never finishes if a copy throws,
+  // so the buffer is released here before rethrowing
+  void NumsInit(size_type n, const T& value) {
     size_type initsize = easystl::Max(static_cast<size_type>(n), static_cast<size_type>(16));
     iterator current = DataAllocator::Allocate(initsize);
+    try {
+      end_ = easystl::uninitialized_fill_n(current, n, value);
+    }
+    catch(...) {
+      DataAllocator::Deallocate(current, initsize);
+      throw;
+    }
     begin_ = current;
-    end_  = easystl::uninitialized_fill_n(current, n, value);
     capacity_ = begin_ + initsize;
   }
   // range init
   template <class Iter>
-  void RangeInit(Iter first, Iter last) noexcept {
+  void RangeInit(Iter first, Iter last) {
     size_type initsize = easystl::Max(static_cast<size_type>(last - first), static_cast<size_type>(16));
-    begin_ =  DataAllocator::Allocate(initsize);
-    end_ = easystl::uninitialized_copy(first, last, begin_);
+    iterator current = DataAllocator::Allocate(initsize);
+    try {
+      end_ = easystl::uninitialized_copy(first, last, current);
+    }
+    catch(...) {
+      DataAllocator::Deallocate(current, initsize);
+      throw;
+    }
+    begin_ = current;
     capacity_ = begin_ + initsize;
   }
   // destroy and Deallocate
@@ -235,14 +276,67 @@ class vector {
       DataAllocator::Deallocate(first, len);
     }
   }
+ // new capacity for nums more elements
+ // double the size, but never less than what is needed
+  size_type GrowthSize(size_type nums) const noexcept {
+    return Max(Max(size() * 2, size() + nums), static_cast<size_type>(16));
+  }
+ // grow to exactly n elements of capacity
+  void ReserveAux(size_type n, TrueType) noexcept {
+    const size_type oldsize = size();
+    begin_ = DataAllocator::Reallocate(begin_, capacity(), n);
+    end_ = begin_ + oldsize;
+    capacity_ = begin_ + n;
+  }
+  void ReserveAux(size_type n, FalseType) {
+    iterator newbegin = DataAllocator::Allocate(n);
+    iterator newend = newbegin;
+    try {
+      newend = easystl::uninitialized_copy(begin_, end_, newbegin);
+    }
+    catch(...) {
+      DestroynDeallocate(newbegin, newend, n);
+      throw;
+    }
+    DestroynDeallocate(begin_, end_, static_cast<size_type>(capacity_ - begin_));
+    begin_ = newbegin;
+    end_ = newend;
+    capacity_ = begin_ + n;
+  }
  // inesert when space not enough
-  void InsertAux(iterator pos, size_type nums, const T& x) noexcept {
-    const size_type newsize = Max(size()*2, static_cast<size_type>(16));
+  void InsertAux(iterator pos, size_type nums, const T& x) {
+    InsertAux(pos, nums, x, IsTriviallyCopyable<T>());
+  }
+ // trivially copyable elements are moved with their bytes, so the
+ // block can grow through Alloc::Reallocate (in place, or mremap
+ // for large blocks) instead of allocate + copy + free
+  void InsertAux(iterator pos, size_type nums, const T& x, TrueType) noexcept {
+    const T value = x; // x may live in the old block
+    const size_type offset = static_cast<size_type>(pos - begin_);
+    const size_type oldsize = size();
+    const size_type newsize = GrowthSize(nums);
+    begin_ = DataAllocator::Reallocate(begin_, capacity(), newsize);
+    pos = begin_ + offset;
+    Copybackward(pos, begin_ + oldsize, begin_ + oldsize + nums);
+    easystl::uninitialized_fill_n(pos, nums, value);
+    end_ = begin_ + oldsize + nums;
+    capacity_ = begin_ + newsize;
+  }
+ // everything is built in a new buffer first, the old one is only
+ // released on success, so a throwing copy leaves *this untouched
+  void InsertAux(iterator pos, size_type nums, const T& x, FalseType) {
+    const size_type newsize = GrowthSize(nums);
     iterator newbegin = DataAllocator::Allocate(newsize);
     iterator newend = newbegin;
-    newend = uninitialized_copy(begin_, pos, newbegin);
-    newend = uninitialized_fill_n(newend, nums, x);
-    newend = uninitialized_copy(pos, end_, newend);
+    try {
+      newend = easystl::uninitialized_copy(begin_, pos, newbegin);
+      newend = easystl::uninitialized_fill_n(newend, nums, x);
+      newend = easystl::uninitialized_copy(pos, end_, newend);
+    }
+    catch(...) {
+      DestroynDeallocate(newbegin, newend, newsize);
+      throw;
+    }
     DestroynDeallocate(begin_, end_, static_cast<size_type>(capacity_ - begin_));
     begin_ = newbegin;
     end_ = newend;
@@ -251,20 +345,59 @@ class vector {
   template<class Iter1, class Iter2,
     typename std::enable_if_t<IsIterator<Iter1>::value, int> = 0,
     typename std::enable_if_t<IsIterator<Iter2>::value, int> = 0>
-  void InsertAux(Iter1 pos, Iter2 first, Iter2 last) noexcept {
-    {
-      const size_type newsize = Max(size() * 2, static_cast<size_type>(16));
-      iterator newbegin = DataAllocator::Allocate(newsize);
-      iterator newend = newbegin;
-      newend = uninitialized_copy(begin_, pos, newbegin);
-      newend = uninitialized_copy(first, last, newend);
-      newend = uninitialized_copy(pos, end_, newend);
-      DestroynDeallocate(begin_, end_, static_cast<size_type>(capacity_ - begin_));
-      begin_ = newbegin;
-      end_ = newend;
-      capacity_ = begin_ + newsize;
+  void InsertAux(Iter1 pos, Iter2 first, Iter2 last) {
+    InsertAux(static_cast<iterator>(pos), first, last,
+              BoolConstant<IsTriviallyCopyable<T>::value &&
+                std::is_nothrow_constructible<T, typename IteratorTraits<Iter2>::Reference>::value>());
+  }
+ // same as the fill overload: grow through Alloc::Reallocate, shift
+ // the tail and copy the range into the gap. a range inside the old
+ // block would move with it, so it takes the copying path instead
+  template<class Iter>
+  void InsertAux(iterator pos, Iter first, Iter last, TrueType) {
+    if (InBlock(first, last, IsContiguousIterator<Iter>())) {
+      InsertAux(pos, first, last, FalseType());
+      return ;
+    }
+    const size_type nums = static_cast<size_type>(Distance(first, last));
+    const size_type offset = static_cast<size_type>(pos - begin_);
+    const size_type oldsize = size();
+    const size_type newsize = GrowthSize(nums);
+    begin_ = DataAllocator::Reallocate(begin_, capacity(), newsize);
+    pos = begin_ + offset;
+    Copybackward(pos, begin_ + oldsize, begin_ + oldsize + nums);
+    easystl::uninitialized_copy(first, last, pos);
+    end_ = begin_ + oldsize + nums;
+    capacity_ = begin_ + newsize;
+  }
+  template<class Iter>
+  void InsertAux(iterator pos, Iter first, Iter last, FalseType) {
+    const size_type newsize = GrowthSize(static_cast<size_type>(Distance(first, last)));
+    iterator newbegin = DataAllocator::Allocate(newsize);
+    iterator newend = newbegin;
+    try {
+      newend = easystl::uninitialized_copy(begin_, pos, newbegin);
+      newend = easystl::uninitialized_copy(first, last, newend);
+      newend = easystl::uninitialized_copy(pos, end_, newend);
+    }
+    catch(...) {
+      DestroynDeallocate(newbegin, newend, newsize);
+      throw;
     }
+    DestroynDeallocate(begin_, end_, static_cast<size_type>(capacity_ - begin_));
+    begin_ = newbegin;
+    end_ = newend;
+    capacity_ = begin_ + newsize;
+  }
+ // [first, last) points into our own block
+  template<class Iter>
+  bool InBlock(Iter first, Iter last, TrueType) const noexcept {
+    if (first == last || nullptr == begin_) { return false; }
+    const T* p = ToAddress(first);
+    return !(p < begin_ || p >= capacity_);
   }
+  template<class Iter>
+  bool InBlock(Iter, Iter, FalseType) const noexcept { return false; }
 
   // flag
   iterator begin_;    // flag for used memory head 
@@ -0,0 +1,456 @@
+#ifndef EASYSTL_VIEWS_H_
+#define EASYSTL_VIEWS_H_
+
+#include <type_traits>
+#include <utility>
+#include "iterator.h"
+#include "vector.h"
+
+namespace easystl {
+namespace views {
+
+// lazy range views
+// a view is a cheap object with begin() and end(); nothing is
+// computed until it is iterated, and a chain of views runs as a
+// single loop over the source. views hold their source by pointer
+// (containers) or by value (other views), so a container must
+// outlive every view over it. a view knows its size() when it can
+// be computed without iterating, ToVector uses it to allocate once.
+//
+//   auto v = ToVector(data | views::filter(odd) | views::transform(twice) | views::take(10));
+
+class ViewBase {};
+
+template<class T>
+class IsView : public BoolConstant<std::is_base_of<ViewBase, typename std::decay<T>::type>::value> {};
+
+template<class View>
+using ViewIterator = decltype(std::declval<const View&>().begin());
+
+// [first, last) of any iterator
+template<class Iter>
+class IterRange : public ViewBase {
+ public:
+  IterRange() : first_(), last_() {}
+  IterRange(Iter first, Iter last) : first_(first), last_(last) {}
+  Iter begin() const { return first_; }
+  Iter end() const { return last_; }
+  // only where it costs nothing, counting would consume a single pass range
+  template<class I = Iter, typename std::enable_if_t<std::is_base_of<RandomAccessIteratorTag,
+    typename IteratorTraits<I>::IteratorCategory>::value, int> = 0>
+  size_t size() const { return static_cast<size_t>(Distance(first_, last_)); }
+  bool empty() const { return first_ == last_; }
+
+ private:
+  Iter first_;
+  Iter last_;
+};
+
+template<class Iter>
+IterRange<Iter> range(Iter first, Iter last) { return IterRange<Iter>(first, last); }
+
+// view over a container, by pointer
+template<class Container>
+class RefView : public ViewBase {
+ public:
+  explicit RefView(Container& c) : c_(&c) {}
+  auto begin() const -> decltype(std::declval<Container&>().begin()) { return c_->begin(); }
+  auto end() const -> decltype(std::declval<Container&>().end()) { return c_->end(); }
+  size_t size() const { return static_cast<size_t>(c_->size()); }
+
+ private:
+  Container* c_;
+};
+
+// views are copied, containers are referenced
+template<class View, typename std::enable_if_t<IsView<View>::value, int> = 0>
+typename std::decay<View>::type All(View&& v) { return v; }
+
+template<class Container, typename std::enable_if_t<!IsView<Container>::value, int> = 0>
+RefView<Container> All(Container& c) { return RefView<Container>(c); }
+
+template<class Range>
+using AllType = decltype(All(std::declval<Range>()));
+
+// size of a view if it has one
+template<class View, class = void>
+class HasSize : public FalseType {};
+
+template<class View>
+class HasSize<View, void_t<decltype(std::declval<const View&>().size())>> : public TrueType {};
+
+// ---------------------------------------------------------------- transform
+
+template<class Base, class Func>
+class TransformView : public ViewBase {
+ public:
+  using BaseIter = ViewIterator<Base>;
+  using Result = decltype(std::declval<const Func&>()(*std::declval<BaseIter>()));
+  using Value = typename std::decay<Result>::type;
+
+  class iterator : public Iterator<ForwardIteratorTag, Value, ptrdiff_t, Value*, Result> {
+   public:
+    iterator() : it_(), func_(nullptr) {}
+    iterator(BaseIter it, const Func* func) : it_(it), func_(func) {}
+    Result operator*() const { return (*func_)(*it_); }
+    iterator& operator++() { ++it_; return *this; }
+    iterator operator++(int) { iterator tmp = *this; ++it_; return tmp; }
+    bool operator==(const iterator& rhs) const { return it_ == rhs.it_; }
+    bool operator!=(const iterator& rhs) const { return it_ != rhs.it_; }
+
+   private:
+    BaseIter it_;
+    const Func* func_;
+  };
+
+  TransformView(Base base, Func func) : base_(base), func_(func) {}
+  iterator begin() const { return iterator(base_.begin(), &func_); }
+  iterator end() const { return iterator(base_.end(), &func_); }
+  template<class B = Base>
+  auto size() const -> decltype(std::declval<const B&>().size()) { return base_.size(); }
+
+ private:
+  Base base_;
+  Func func_;
+};
+
+// ---------------------------------------------------------------- filter
+
+template<class Base, class Pred>
+class FilterView : public ViewBase {
+ public:
+  using BaseIter = ViewIterator<Base>;
+  using Traits = IteratorTraits<BaseIter>;
+
+  class iterator : public Iterator<ForwardIteratorTag, typename Traits::ValueType, ptrdiff_t,
+                                   typename Traits::Pointer, typename Traits::Reference> {
+   public:
+    iterator() : it_(), last_(), pred_(nullptr) {}
+    iterator(BaseIter it, BaseIter last, const Pred* pred) : it_(it), last_(last), pred_(pred) { Skip(); }
+    typename Traits::Reference operator*() const { return *it_; }
+    iterator& operator++() { ++it_; Skip(); return *this; }
+    iterator operator++(int) { iterator tmp = *this; ++*this; return tmp; }
+    bool operator==(const iterator& rhs) const { return it_ == rhs.it_; }
+    bool operator!=(const iterator& rhs) const { return it_ != rhs.it_; }
+
+   private:
+    void Skip() { while (it_ != last_ && !(*pred_)(*it_)) { ++it_; } }
+    BaseIter it_;
+    BaseIter last_;
+    const Pred* pred_;
+  };
+
+  FilterView(Base base, Pred pred) : base_(base), pred_(pred) {}
+  iterator begin() const { return iterator(base_.begin(), base_.end(), &pred_); }
+  iterator end() const { return iterator(base_.end(), base_.end(), &pred_); }
+
+ private:
+  Base base_;
+  Pred pred_;
+};
+
+// ---------------------------------------------------------------- take
+
+template<class Base>
+class TakeView : public ViewBase {
+ public:
+  using BaseIter = ViewIterator<Base>;
+  using Traits = IteratorTraits<BaseIter>;
+
+  // finished when n elements were taken or the base ran out
+  class iterator : public Iterator<ForwardIteratorTag, typename Traits::ValueType, ptrdiff_t,
+                                   typename Traits::Pointer, typename Traits::Reference> {
+   public:
+    iterator() : it_(), last_(), n_(0) {}
+    iterator(BaseIter it, BaseIter last, size_t n) : it_(it), last_(last), n_(n) {}
+    typename Traits::Reference operator*() const { return *it_; }
+    iterator& operator++() { ++it_; --n_; return *this; }
+    iterator operator++(int) { iterator tmp = *this; ++*this; return tmp; }
+    bool operator==(const iterator& rhs) const {
+      const bool done = Done(), rhsdone = rhs.Done();
+      return done || rhsdone ? done == rhsdone : it_ == rhs.it_;
+    }
+    bool operator!=(const iterator& rhs) const { return !(*this == rhs); }
+
+   private:
+    bool Done() const { return n_ == 0 || it_ == last_; }
+    BaseIter it_;
+    BaseIter last_;
+    size_t n_;
+  };
+
+  TakeView(Base base, size_t n) : base_(base), n_(n) {}
+  iterator begin() const { return iterator(base_.begin(), base_.end(), n_); }
+  iterator end() const { return iterator(base_.end(), base_.end(), 0); }
+  template<class B = Base>
+  auto size() const -> decltype(std::declval<const B&>().size()) {
+    return base_.size() < n_ ? base_.size() : n_;
+  }
+
+ private:
+  Base base_;
+  size_t n_;
+};
+
+// ---------------------------------------------------------------- drop
+
+// first + n, but never past last
+template<class Iter>
+Iter __DropBegin(Iter first, Iter last, size_t n, InputIteratorTag) {
+  for (; n > 0 && first != last; --n) { ++first; }
+  return first;
+}
+
+// random access: one jump, O(1)
+template<class Iter>
+Iter __DropBegin(Iter first, Iter last, size_t n, RandomAccessIteratorTag) {
+  const auto len = Distance(first, last);
+  Advance(first, static_cast<size_t>(len) < n ? len : static_cast<decltype(len)>(n));
+  return first;
+}
+
+template<class Base>
+class DropView : public ViewBase {
+ public:
+  using BaseIter = ViewIterator<Base>;
+
+  DropView(Base base, size_t n) : base_(base), n_(n) {}
+  BaseIter begin() const {
+    return __DropBegin(base_.begin(), base_.end(), n_,
+                       typename IteratorTraits<BaseIter>::IteratorCategory());
+  }
+  BaseIter end() const { return base_.end(); }
+  template<class B = Base>
+  auto size() const -> decltype(std::declval<const B&>().size()) {
+    return base_.size() > n_ ? base_.size() - n_ : 0;
+  }
+
+ private:
+  Base base_;
+  size_t n_;
+};
+
+// ---------------------------------------------------------------- zip
+
+template<class Base1, class Base2>
+class ZipView : public ViewBase {
+ public:
+  using Iter1 = ViewIterator<Base1>;
+  using Iter2 = ViewIterator<Base2>;
+  using Reference = std::pair<typename IteratorTraits<Iter1>::Reference,
+                              typename IteratorTraits<Iter2>::Reference>;
+  using Value = std::pair<typename IteratorTraits<Iter1>::ValueType,
+                          typename IteratorTraits<Iter2>::ValueType>;
+
+  // finished as soon as either side ran out
+  class iterator : public Iterator<ForwardIteratorTag, Value, ptrdiff_t, Value*, Reference> {
+   public:
+    iterator() : it1_(), last1_(), it2_(), last2_() {}
+    iterator(Iter1 it1, Iter1 last1, Iter2 it2, Iter2 last2)
+      : it1_(it1), last1_(last1), it2_(it2), last2_(last2) {}
+    Reference operator*() const { return Reference(*it1_, *it2_); }
+    iterator& operator++() { ++it1_; ++it2_; return *this; }
+    iterator operator++(int) { iterator tmp = *this; ++*this; return tmp; }
+    bool operator==(const iterator& rhs) const {
+      const bool done = Done(), rhsdone = rhs.Done();
+      return done || rhsdone ? done == rhsdone : it1_ == rhs.it1_;
+    }
+    bool operator!=(const iterator& rhs) const { return !(*this == rhs); }
+
+   private:
+    bool Done() const { return it1_ == last1_ || it2_ == last2_; }
+    Iter1 it1_;
+    Iter1 last1_;
+    Iter2 it2_;
+    Iter2 last2_;
+  };
+
+  ZipView(Base1 base1, Base2 base2) : base1_(base1), base2_(base2) {}
+  iterator begin() const { return iterator(base1_.begin(), base1_.end(), base2_.begin(), base2_.end()); }
+  iterator end() const { return iterator(base1_.end(), base1_.end(), base2_.end(), base2_.end()); }
+  template<class B1 = Base1, class B2 = Base2>
+  auto size() const -> decltype(std::declval<const B1&>().size() + std::declval<const B2&>().size()) {
+    return base1_.size() < base2_.size() ? base1_.size() : base2_.size();
+  }
+
+ private:
+  Base1 base1_;
+  Base2 base2_;
+};
+
+// ---------------------------------------------------------------- chunk
+
+// consecutive sub-ranges of n elements, the last one may be shorter
+template<class Base>
+class ChunkView : public ViewBase {
+ public:
+  using BaseIter = ViewIterator<Base>;
+  using Value = IterRange<BaseIter>;
+
+  class iterator : public Iterator<ForwardIteratorTag, Value, ptrdiff_t, Value*, Value> {
+   public:
+    iterator() : it_(), next_(), last_(), n_(0) {}
+    iterator(BaseIter it, BaseIter last, size_t n) : it_(it), next_(it), last_(last), n_(n) { Step(); }
+    Value operator*() const { return Value(it_, next_); }
+    iterator& operator++() { it_ = next_; Step(); return *this; }
+    iterator operator++(int) { iterator tmp = *this; ++*this; return tmp; }
+    bool operator==(const iterator& rhs) const { return it_ == rhs.it_; }
+    bool operator!=(const iterator& rhs) const { return it_ != rhs.it_; }
+
+   private:
+    void Step() {
+      for (size_t n = n_; n > 0 && next_ != last_; --n) { ++next_; }
+    }
+    BaseIter it_;   // chunk head
+    BaseIter next_; // chunk tail
+    BaseIter last_;
+    size_t n_;
+  };
+
+  ChunkView(Base base, size_t n) : base_(base), n_(n > 0 ? n : 1) {}
+  iterator begin() const { return iterator(base_.begin(), base_.end(), n_); }
+  iterator end() const { return iterator(base_.end(), base_.end(), n_); }
+  template<class B = Base>
+  auto size() const -> decltype(std::declval<const B&>().size()) { return (base_.size() + n_ - 1) / n_; }
+
+ private:
+  Base base_;
+  size_t n_;
+};
+
+// ---------------------------------------------------------------- enumerate
+
+// (index, element) pairs, index counts from 0
+template<class Base>
+class EnumerateView : public ViewBase {
+ public:
+  using BaseIter = ViewIterator<Base>;
+  using Reference = std::pair<size_t, typename IteratorTraits<BaseIter>::Reference>;
+  using Value = std::pair<size_t, typename IteratorTraits<BaseIter>::ValueType>;
+
+  class iterator : public Iterator<ForwardIteratorTag, Value, ptrdiff_t, Value*, Reference> {
+   public:
+    iterator() : it_(), index_(0) {}
+    iterator(BaseIter it, size_t index) : it_(it), index_(index) {}
+    Reference operator*() const { return Reference(index_, *it_); }
+    iterator& operator++() { ++it_; ++index_; return *this; }
+    iterator operator++(int) { iterator tmp = *this; ++*this; return tmp; }
+    bool operator==(const iterator& rhs) const { return it_ == rhs.it_; }
+    bool operator!=(const iterator& rhs) const { return it_ != rhs.it_; }
+
+   private:
+    BaseIter it_;
+    size_t index_;
+  };
+
+  explicit EnumerateView(Base base) : base_(base) {}
+  iterator begin() const { return iterator(base_.begin(), 0); }
+  iterator end() const { return iterator(base_.end(), 0); }
+  template<class B = Base>
+  auto size() const -> decltype(std::declval<const B&>().size()) { return base_.size(); }
+
+ private:
+  Base base_;
+};
+
+// ---------------------------------------------------------------- adaptors
+
+// holds the arguments of a view until it meets its source in operator|
+template<class Make>
+class Adaptor {
+ public:
+  explicit Adaptor(Make make) : make_(make) {}
+  template<class Range>
+  auto operator()(Range&& r) const -> decltype(std::declval<const Make&>()(All(std::forward<Range>(r)))) {
+    return make_(All(std::forward<Range>(r)));
+  }
+
+ private:
+  Make make_;
+};
+
+template<class Make>
+Adaptor<Make> MakeAdaptor(Make make) { return Adaptor<Make>(make); }
+
+template<class Range, class Make>
+auto operator|(Range&& r, const Adaptor<Make>& adaptor) -> decltype(adaptor(std::forward<Range>(r))) {
+  return adaptor(std::forward<Range>(r));
+}
+
+template<class Func>
+auto transform(Func func) {
+  return MakeAdaptor([func](auto base) { return TransformView<decltype(base), Func>(base, func); });
+}
+
+template<class Pred>
+auto filter(Pred pred) {
+  return MakeAdaptor([pred](auto base) { return FilterView<decltype(base), Pred>(base, pred); });
+}
+
+inline auto take(size_t n) {
+  return MakeAdaptor([n](auto base) { return TakeView<decltype(base)>(base, n); });
+}
+
+inline auto drop(size_t n) {
+  return MakeAdaptor([n](auto base) { return DropView<decltype(base)>(base, n); });
+}
+
+inline auto chunk(size_t n) {
+  return MakeAdaptor([n](auto base) { return ChunkView<decltype(base)>(base, n); });
+}
+
+inline auto enumerate() {
+  return MakeAdaptor([](auto base) { return EnumerateView<decltype(base)>(base); });
+}
+
+// zip with a second range, taken the same way as the left side
+template<class Range>
+auto zip(Range&& other) {
+  auto second = All(std::forward<Range>(other));
+  return MakeAdaptor([second](auto base) { return ZipView<decltype(base), decltype(second)>(base, second); });
+}
+
+// ---------------------------------------------------------------- materialize
+
+template<class View>
+void __Reserve(const View& view, size_t& n, TrueType) { n = static_cast<size_t>(view.size()); }
+
+template<class View>
+void __Reserve(const View&, size_t& n, FalseType) { n = 0; }
+
+// run the whole chain once and collect the elements
+// when the length is known the vector is allocated once up front
+template<class Alloc = Allo, class Range>
+auto ToVector(Range&& r) -> vector<typename IteratorTraits<ViewIterator<AllType<Range>>>::ValueType, Alloc> {
+  using Value = typename IteratorTraits<ViewIterator<AllType<Range>>>::ValueType;
+  auto view = All(std::forward<Range>(r));
+  vector<Value, Alloc> result;
+  size_t n = 0;
+  __Reserve(view, n, HasSize<decltype(view)>());
+  if (n > 0) { result.reserve(n); }
+  for (auto it = view.begin(), last = view.end(); it != last; ++it) {
+    result.push_back(*it);
+  }
+  return result;
+}
+
+// terminal of a pipeline: r | views::to_vector
+class ToVectorTag {};
+static constexpr ToVectorTag to_vector{};
+
+template<class Range>
+auto operator|(Range&& r, ToVectorTag) -> decltype(ToVector(std::forward<Range>(r))) {
+  return ToVector(std::forward<Range>(r));
+}
+
+// call func on every element, the pipeline runs as one loop
+template<class Range, class Func>
+void ForEach(Range&& r, Func func) {
+  auto view = All(std::forward<Range>(r));
+  for (auto it = view.begin(), last = view.end(); it != last; ++it) { func(*it); }
+}
+
+} // namespace views
+} // namespace easystl
+
+#endif // EASYSTL_VIEWS_H_
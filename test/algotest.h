@@ -0,0 +1,98 @@
+#include <cstring>
+#include <iostream>
+#include <string>
+#include "test.h"
+#include "algo.h"
+#include "iterator.h"
+#include "uninitialized.h"
+
+// pointer wrapper, Tag decides which copy path the library takes
+template<class T, class Tag>
+class TestIterator : public easystl::Iterator<Tag, T> {
+ public:
+  using Self = TestIterator<T, Tag>;
+  explicit TestIterator(T* p) : p_(p) {}
+  T& operator*() const { return *p_; }
+  Self& operator++() { ++p_; return *this; }
+  Self& operator--() { --p_; return *this; }
+  Self& operator+=(ptrdiff_t n) { p_ += n; return *this; }
+  Self& operator-=(ptrdiff_t n) { p_ -= n; return *this; }
+  Self operator+(ptrdiff_t n) const { return Self(p_ + n); }
+  ptrdiff_t operator-(const Self& rhs) const { return p_ - rhs.p_; }
+  bool operator==(const Self& rhs) const { return p_ == rhs.p_; }
+  bool operator!=(const Self& rhs) const { return p_ != rhs.p_; }
+
+ private:
+  T* p_;
+};
+
+template<class T>
+using ContiguousTestIterator = TestIterator<T, easystl::ContiguousIteratorTag>;
+template<class T>
+using RandomAccessTestIterator = TestIterator<T, easystl::RandomAccessIteratorTag>;
+
+static_assert(easystl::IsContiguousIterator<int*>::value, "pointer is contiguous");
+static_assert(easystl::IsContiguousIterator<ContiguousTestIterator<int>>::value, "wrapper is contiguous");
+static_assert(!easystl::IsContiguousIterator<RandomAccessTestIterator<int>>::value, "wrapper is not contiguous");
+static_assert(easystl::IsMemCopyable<const int*, int*>::value, "int copies with memmove");
+static_assert(easystl::IsMemCopyable<ContiguousTestIterator<int>, int*>::value, "wrapper copies with memmove");
+static_assert(!easystl::IsMemCopyable<const std::string*, std::string*>::value, "string copies one by one");
+static_assert(easystl::IsMemFillable<char*, char>::value, "char fills with memset");
+
+template<size_t N>
+std::string Join(const int (&a)[N]) {
+  std::string s;
+  for (size_t i = 0; i < N; ++i) { s += (i ? " " : "") + std::to_string(a[i]); }
+  return s;
+}
+
+// Copy and Copybackward through iterator type Iter, on overlapping ranges
+template<class Iter>
+void OverlapCopyTest(const char* name) {
+  int a[10] = { 0,1,2,3,4,5,6,7,8,9 };
+  Iter end = easystl::Copy(Iter(a + 2), Iter(a + 8), Iter(a));
+  std::cout << " " << name << " Copy(a + 2, a + 8, a) : " << Join(a) << "\n";
+  EXPECT(Join(a) == "2 3 4 5 6 7 6 7 8 9");
+  EXPECT((end == Iter(a + 6)));
+  int b[10] = { 0,1,2,3,4,5,6,7,8,9 };
+  Iter begin = easystl::Copybackward(Iter(b), Iter(b + 6), Iter(b + 8));
+  std::cout << " " << name << " Copybackward(b, b + 6, b + 8) : " << Join(b) << "\n";
+  EXPECT(Join(b) == "0 1 0 1 2 3 4 5 8 9");
+  EXPECT((begin == Iter(b + 2)));
+}
+
+void AlgoTest()
+{
+  std::cout << "[----------------- algo test -----------------]\n";
+  OverlapCopyTest<int*>("int*");
+  OverlapCopyTest<ContiguousTestIterator<int>>("ContiguousTestIterator");
+  OverlapCopyTest<RandomAccessTestIterator<int>>("RandomAccessTestIterator");
+  // memset path, the byte of the value and nothing past last
+  char buf[8] = { 0 };
+  easystl::Fill(buf, buf + 6, 'x');
+  FUN_VALUE(buf);
+  EXPECT(std::strcmp(buf, "xxxxxx") == 0);
+  signed char sbuf[4] = { 0 };
+  easystl::Fill(sbuf, sbuf + 3, static_cast<signed char>(-1));
+  EXPECT(sbuf[0] == -1 && sbuf[2] == -1 && sbuf[3] == 0);
+  int ibuf[5] = { 0 };
+  easystl::Fill(ContiguousTestIterator<int>(ibuf), ContiguousTestIterator<int>(ibuf + 4), 0x01020304);
+  FUN_VALUE(Join(ibuf));
+  EXPECT(Join(ibuf) == "16909060 16909060 16909060 16909060 0");
+  // empty ranges are left alone
+  easystl::Fill(buf, buf, 'y');
+  EXPECT(easystl::Copy(ibuf, ibuf, ibuf + 1) == ibuf + 1);
+  EXPECT(buf[0] == 'x');
+  // uninitialized_copy through the contiguous wrapper
+  int src[4] = { 5,6,7,8 };
+  int dst[4] = { 0 };
+  easystl::uninitialized_copy(ContiguousTestIterator<int>(src), ContiguousTestIterator<int>(src + 4), dst);
+  FUN_VALUE(Join(dst));
+  EXPECT(Join(dst) == "5 6 7 8");
+  // non trivially copyable elements take the element by element path
+  std::string s[4] = { "a", "b", "c", "d" };
+  easystl::Copy(s + 1, s + 4, s);
+  FUN_VALUE((s[0] + s[1] + s[2] + s[3]));
+  EXPECT(s[0] + s[1] + s[2] + s[3] == "bcdd");
+  std::cout << "[----------------- End -----------------]\n";
+}
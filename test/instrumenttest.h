@@ -0,0 +1,66 @@
+#include <iostream>
+#include "test.h"
+#include "instrument.h"
+#include "vector.h"
+
+// growth regressions caught by counters instead of by reading the
+// bench tables: a trivially copyable vector must grow with one
+// Reallocate and no new block, any other type copies each element
+// exactly once
+template<class T>
+using CheckedVector = easystl::vector<T, CountingAllocator<easystl::Allo>>;
+
+inline void ResetInstrumentCounters() {
+  ResetAllocCounters();
+  ResetElementCounters();
+}
+
+void InstrumentTest()
+{
+  std::cout << "[----------------- instrument test -----------------]\n";
+  InstrumentHeader();
+  {
+    CheckedVector<int> v;
+    for (int i = 0; i < 1000; ++i) v.push_back(i);
+    while (v.size() < v.capacity()) v.push_back(0);
+    ResetInstrumentCounters();
+    v.push_back(1);
+    InstrumentLine("int growth");
+    EXPECT(GetAllocCounters().reallocations == 1);
+    EXPECT(GetAllocCounters().allocations == 0);
+    EXPECT(GetAllocCounters().deallocations == 0);
+    while (v.size() < v.capacity()) v.push_back(0);
+    int a[] = { 1, 2, 3 };
+    ResetInstrumentCounters();
+    v.insert(v.begin() + 10, a, a + 3);
+    InstrumentLine("int range insert growth");
+    EXPECT(GetAllocCounters().reallocations == 1);
+    EXPECT(GetAllocCounters().allocations == 0);
+    ResetInstrumentCounters();
+    v.reserve(v.capacity() * 2);
+    InstrumentLine("int reserve");
+    EXPECT(GetAllocCounters().reallocations == 1);
+    EXPECT(GetAllocCounters().allocations == 0);
+  }
+  {
+    CheckedVector<CountedValue> v;
+    for (int i = 0; i < 1000; ++i) v.push_back(i);
+    while (v.size() < v.capacity()) v.push_back(0);
+    const int64_t oldsize = static_cast<int64_t>(v.size());
+    const CountedValue x(1);
+    ResetInstrumentCounters();
+    v.push_back(x);
+    InstrumentLine("CountedValue growth");
+    EXPECT(GetElementCounters().copies == static_cast<int64_t>(v.size()));
+    EXPECT(GetElementCounters().destroys == oldsize);
+    EXPECT(GetAllocCounters().allocations == 1);
+    EXPECT(GetAllocCounters().deallocations == 1);
+    EXPECT(GetAllocCounters().reallocations == 0);
+    ResetInstrumentCounters();
+    v.push_back(x);
+    InstrumentLine("CountedValue push_back");
+    EXPECT(GetElementCounters().copies == 1);
+    EXPECT(GetAllocCounters().allocations == 0);
+  }
+  std::cout << "[----------------- End -----------------]\n";
+}
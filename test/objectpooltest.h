@@ -0,0 +1,88 @@
+
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include "test.h"
+#include "object_pool.h"
+
+struct PoolEntity {
+  PoolEntity(int i, const std::string& n) : id(i), name(n) {}
+  int id;
+  std::string name;
+};
+
+void ObjectPoolTest()
+{
+  std::cout << "[----------------- object pool test -----------------]\n";
+  using Pool = easystl::ObjectPool<PoolEntity>;
+  Pool pool;
+  FUN_VALUE(Pool::kSlabObjects);
+  PoolEntity* a = pool.Create(1, "first");
+  Pool::Handle hb = pool.CreateHandle(2, "second");
+  Pool::Handle hc = pool.CreateHandle(3, "third");
+  FUN_VALUE(pool.size());
+  FUN_VALUE(pool.capacity());
+  FUN_VALUE(a->name);
+  FUN_VALUE(pool.Get(hb)->name);
+  std::cout << std::boolalpha;
+  FUN_VALUE((pool.Get(pool.HandleOf(a)) == a));
+  // handle goes stale, the reused slot gets a new generation
+  FUN_VALUE(pool.Destroy(hb));
+  FUN_VALUE(pool.Valid(hb));
+  FUN_VALUE(pool.Destroy(hb));
+  Pool::Handle hd = pool.CreateHandle(4, "fourth");
+  FUN_VALUE((hd.Index() == hb.Index()));
+  FUN_VALUE((hd != hb));
+  FUN_VALUE((pool.Get(hb) == nullptr));
+  FUN_VALUE(pool.Get(hd)->name);
+  pool.Destroy(a);
+  FUN_VALUE(pool.size());
+  // fill more than one slab
+  for (int i = 0; i < 200; ++i) pool.Create(100 + i, "bulk");
+  FUN_VALUE(pool.size());
+  FUN_VALUE(pool.capacity());
+  long long sum = 0;
+  pool.ForEach([&sum](PoolEntity& e) { sum += e.id; });
+  FUN_VALUE(sum);
+  pool.DestroyAll();
+  FUN_VALUE(pool.size());
+  FUN_VALUE(pool.Valid(hc));
+  FUN_VALUE(pool.Valid(hd));
+  FUN_VALUE(pool.Create(5, "after")->id);
+  // a slot reused by one destroy/create churn runs out of
+  // generations and is retired, the old handle never comes back
+  Pool::Handle stale = pool.CreateHandle(6, "stale");
+  pool.Destroy(stale);
+  for (int i = 0; i < 5000; ++i) {
+    Pool::Handle h = pool.CreateHandle(i, "churn");
+    EXPECT(pool.Valid(h));
+    EXPECT(!pool.Valid(stale));
+    pool.Destroy(h);
+  }
+  FUN_VALUE(pool.Valid(stale));
+  EXPECT(!pool.Valid(stale));
+  // destroying twice through a pointer is refused
+  PoolEntity* e = pool.Create(7, "twice");
+  const size_t size = pool.size();
+  FUN_VALUE(pool.Destroy(e));
+  FUN_VALUE(pool.Destroy(e));
+  EXPECT(pool.size() == size - 1);
+  EXPECT(!pool.HandleOf(e));
+  PoolEntity* e1 = pool.Create(8, "one");
+  PoolEntity* e2 = pool.Create(9, "two");
+  EXPECT(e1 != e2);
+  PoolEntity outside(10, "outside");
+  EXPECT(!pool.Destroy(&outside));
+  // the slot cap throws instead of aborting
+  easystl::ObjectPool<char> chars;
+  bool thrown = false;
+  try {
+    for (uint32_t i = 0; i <= easystl::kObjectIndexMask + 1; ++i) chars.Create('x');
+  }
+  catch (const std::length_error&) { thrown = true; }
+  FUN_VALUE(thrown);
+  FUN_VALUE(chars.size());
+  EXPECT(thrown && chars.size() == size_t(easystl::kObjectIndexMask) + 1);
+  std::cout << std::noboolalpha;
+  std::cout << "[----------------- End -----------------]\n";
+}
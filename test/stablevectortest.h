@@ -0,0 +1,77 @@
+
+#include <iostream>
+#include "test.h"
+#include "stable_vector.h"
+
+using StableIntVector = easystl::stable_vector<int>;
+static_assert(std::is_convertible<StableIntVector::iterator, StableIntVector::const_iterator>::value,
+              "iterator converts to const_iterator");
+static_assert(!std::is_convertible<StableIntVector::const_iterator, StableIntVector::iterator>::value,
+              "const_iterator must not convert to iterator");
+
+void StableVectorTest()
+{
+  std::cout << "[----------------- stable_vector test -----------------]\n";
+  int a[] = { 1,2,3,4,5 };
+  easystl::stable_vector<int> v1;
+  easystl::stable_vector<int> v2(10);
+  easystl::stable_vector<int> v3(10, 1);
+  easystl::stable_vector<int> v4(a + 0, a + 5);
+  easystl::stable_vector<int> v5(v3);
+  easystl::stable_vector<int> v6{ 1,2,3,4,5,6,7,8,9 };
+  easystl::stable_vector<int> v7;
+  v7 = v6;
+
+  COUT(v2);
+  COUT(v3);
+  COUT(v4);
+  COUT(v5);
+  COUT(v7);
+  FUN_AFTER(v1, v1.push_back(6));
+  FUN_AFTER(v1, v1.pop_back());
+  FUN_AFTER(v1, for (int i = 0; i < 40; ++i) v1.push_back(i));
+  FUN_VALUE(v1.size());
+  FUN_VALUE(v1.capacity());
+  FUN_VALUE(v1.segment_count());
+  FUN_VALUE(v1.front());
+  FUN_VALUE(v1.back());
+  FUN_VALUE(v1[17]);
+  FUN_VALUE(*(v1.begin() + 20));
+  FUN_VALUE(*(v1.end() - 1));
+  FUN_VALUE((v1.end() - v1.begin()));
+  // addresses must not move while growing
+  int* p = &v1[0];
+  for (int i = 0; i < 1000; ++i) v1.push_back(i);
+  std::cout << std::boolalpha;
+  FUN_VALUE((p == &v1[0]));
+  EXPECT(p == &v1[0]);
+  std::cout << std::noboolalpha;
+  FUN_VALUE(v1.size());
+  FUN_VALUE(v1.capacity());
+  FUN_VALUE(v1.segment_count());
+  long long sum = 0;
+  v1.for_each_segment([&sum](const int* first, const int* last) {
+    for (; first != last; ++first) sum += *first;
+  });
+  FUN_VALUE(sum);
+  // iterators follow their elements through swap
+  easystl::stable_vector<int> a1, b1;
+  for (int i = 0; i < 20; ++i) { a1.push_back(i); b1.push_back(1000 + i); }
+  auto it = a1.begin() + 14;
+  a1.swap(b1);
+  ++it; ++it;
+  FUN_VALUE(*it);
+  EXPECT(*it == 16);
+  FUN_VALUE((it - b1.begin()));
+  std::cout << std::boolalpha;
+  FUN_VALUE((a1.begin() == b1.begin()));
+  FUN_VALUE((it == b1.begin() + 16));
+  EXPECT(it == b1.begin() + 16);
+  EXPECT(!(a1.begin() == b1.begin()));
+  std::cout << std::noboolalpha;
+  FUN_AFTER(v4, v4.swap(v6));
+  FUN_AFTER(v4, v4.clear());
+  FUN_VALUE(v4.size());
+  FUN_VALUE(v4.capacity());
+  std::cout << "[----------------- End -----------------]\n";
+}
@@ -1,8 +1,25 @@
 #include "test.h"
 #include "vector.h"
+#include "algotest.h"
 #include "vectortest.h"
+#include "vectordifftest.h"
+#include "instrumenttest.h"
+#include "stablevectortest.h"
+#include "threadcachetest.h"
+#include "objectpooltest.h"
+#include "viewstest.h"
 
 int main()
 {
+  AlgoTest();
   VectorTest();
+  VectorExceptionTest();
+  VectorReallocTest();
+  InstrumentTest();
+  StableVectorTest();
+  ThreadCacheTest();
+  ObjectPoolTest();
+  ViewsTest();
+  const bool diffok = VectorDiffTest();
+  return diffok && TestFailures() == 0 ? 0 : 1;
 }
@@ -27,5 +27,20 @@
   std::cout << " " << fun_name << " : " << fun << "\n";  \
 } while(0)
 
+// number of failed EXPECT checks, main fails when it is not 0
+inline int& TestFailures() {
+  static int failures = 0;
+  return failures;
+}
+
+// silent when cond holds, counts and reports a failure otherwise
+#define EXPECT(cond) do {                                \
+  if (!(cond)) {                                         \
+    ++TestFailures();                                    \
+    std::cout << " FAILED " << #cond << " ("             \
+              << __FILE__ << ":" << __LINE__ << ")\n";   \
+  }                                                      \
+} while(0)
+
 #endif // !MYTINYSTL_TEST_H_
 
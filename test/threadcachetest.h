@@ -0,0 +1,81 @@
+
+#include <cstring>
+#include <iostream>
+#include <thread>
+#include <vector>
+#include "test.h"
+#include "thread_cache.h"
+
+// allocates and frees from its destructor, which runs after the
+// thread's own cache was given up
+class LateTlsUser {
+ public:
+  static bool ok;
+  LateTlsUser() : block_(nullptr) {}
+  ~LateTlsUser() {
+    using Alloc = easystl::ThreadCacheAllocator;
+    void* q = Alloc::Allocate(48);
+    std::memset(q, 1, 48);
+    Alloc::Deallocate(q, 48);
+    if (block_) { Alloc::Deallocate(block_, 32); }
+    ok = q != nullptr;
+  }
+  void* block_;
+};
+bool LateTlsUser::ok = false;
+
+// blocks allocated on one thread and freed on another
+// go back to the allocating thread and are reused there
+void ThreadCacheTest()
+{
+  std::cout << "[----------------- thread cache test -----------------]\n";
+  using Alloc = easystl::ThreadCacheAllocator;
+  const int n = 10000;
+  std::vector<void*> blocks(n);
+  for (auto& p : blocks) p = Alloc::Allocate(32);
+  size_t chunkbytes = Alloc::ChunkBytes();
+  std::thread consumer([&blocks] {
+    for (auto p : blocks) Alloc::Deallocate(p, 32);
+  });
+  consumer.join();
+  // the remote frees must be enough to serve the same amount again
+  for (auto& p : blocks) p = Alloc::Allocate(32);
+  std::cout << std::boolalpha;
+  FUN_VALUE((Alloc::ChunkBytes() == chunkbytes));
+  EXPECT(Alloc::ChunkBytes() == chunkbytes);
+  // many rounds of producer/consumer must not grow the pool
+  for (int round = 0; round < 20; ++round) {
+    std::thread freer([&blocks] {
+      for (auto p : blocks) Alloc::Deallocate(p, 32);
+    });
+    freer.join();
+    for (auto& p : blocks) p = Alloc::Allocate(32);
+  }
+  FUN_VALUE((Alloc::ChunkBytes() == chunkbytes));
+  EXPECT(Alloc::ChunkBytes() == chunkbytes);
+  // local frees stay local
+  void* p = Alloc::Allocate(64);
+  Alloc::Deallocate(p, 64);
+  void* again = Alloc::Allocate(64);
+  FUN_VALUE((again == p));
+  EXPECT(again == p);
+  Alloc::Deallocate(again, 64);
+  for (auto q : blocks) Alloc::Deallocate(q, 32);
+  // a cache left behind by a finished thread is adopted
+  std::thread worker([] {
+    void* q = Alloc::Allocate(16);
+    Alloc::Deallocate(q, 16);
+  });
+  worker.join();
+  FUN_VALUE(Alloc::ChunkBytes() / easystl::kThreadCacheChunkBytes);
+  // thread_local destructors that run after the cache was orphaned
+  std::thread late([] {
+    static thread_local LateTlsUser user; // built before the cache, destroyed after it
+    user.block_ = Alloc::Allocate(32);
+  });
+  late.join();
+  FUN_VALUE(LateTlsUser::ok);
+  EXPECT(LateTlsUser::ok);
+  std::cout << std::noboolalpha;
+  std::cout << "[----------------- End -----------------]\n";
+}
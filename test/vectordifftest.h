@@ -0,0 +1,264 @@
+
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include "test.h"
+#include "vector.h"
+
+// differential test of easystl::vector against std::vector
+// a byte string is decoded into a sequence of operations that is
+// applied to both containers, after every step they must agree.
+// the same decoder is driven by a seeded PRNG (VectorDiffTest) and by
+// libFuzzer (test/vectorfuzz.cpp)
+
+// reads operation arguments, 0 after the input ran out
+class DiffInput {
+ public:
+  DiffInput(const uint8_t* data, size_t size) : data_(data), size_(size), pos_(0) {}
+  bool Empty() const { return pos_ >= size_; }
+  uint8_t Byte() { return pos_ < size_ ? data_[pos_++] : 0; }
+  // value in [0, bound]
+  size_t Below(size_t bound) { return Byte() % (bound + 1); }
+
+ private:
+  const uint8_t* data_;
+  size_t size_;
+  size_t pos_;
+};
+
+// values of the element types under test
+inline void MakeDiffValue(uint8_t seed, int& value) { value = seed; }
+// long strings leave the small string buffer, so copies allocate
+inline void MakeDiffValue(uint8_t seed, std::string& value) {
+  value.assign(seed % 3 == 0 ? 40 : 3, static_cast<char>('a' + seed % 26));
+}
+
+template<class T>
+class VectorDiffer {
+ public:
+  VectorDiffer() : failed_(false), step_(0) {}
+
+  // run one input, true if both containers always matched
+  bool Run(const uint8_t* data, size_t size) {
+    DiffInput in(data, size);
+    while (!in.Empty() && !failed_) {
+      Step(in);
+      Check(ea_, st_, "a");
+      Check(eb_, sb_, "b");
+      ++step_;
+    }
+    return !failed_;
+  }
+
+ private:
+  using EVector = easystl::vector<T>;
+  using SVector = std::vector<T>;
+
+  T Value(DiffInput& in) {
+    T value;
+    MakeDiffValue(in.Byte(), value);
+    return value;
+  }
+
+  void Step(DiffInput& in) {
+    const uint8_t op = in.Byte() % 18;
+    const size_t size = st_.size();
+    switch (op) {
+      case 0: {
+        T x = Value(in);
+        ea_.push_back(x);
+        st_.push_back(x);
+        break;
+      }
+      case 1:
+        if (size > 0) {
+          ea_.pop_back();
+          st_.pop_back();
+        }
+        break;
+      case 2: {
+        size_t pos = in.Below(size);
+        T x = Value(in);
+        auto ei = ea_.insert(ea_.begin() + pos, x);
+        auto si = st_.insert(st_.begin() + pos, x);
+        CheckOffset(ei - ea_.begin(), si - st_.begin(), "insert(pos, x)");
+        break;
+      }
+      case 3: {
+        size_t pos = in.Below(size);
+        size_t n = in.Below(40);
+        T x = Value(in);
+        auto ei = ea_.insert(ea_.begin() + pos, n, x);
+        auto si = st_.insert(st_.begin() + pos, n, x);
+        CheckOffset(ei - ea_.begin(), si - st_.begin(), "insert(pos, n, x)");
+        break;
+      }
+      case 4: {
+        size_t pos = in.Below(size);
+        SVector src = Source(in);
+        auto ei = ea_.insert(ea_.begin() + pos, src.data(), src.data() + src.size());
+        auto si = st_.insert(st_.begin() + pos, src.begin(), src.end());
+        CheckOffset(ei - ea_.begin(), si - st_.begin(), "insert(pos, first, last)");
+        break;
+      }
+      case 5:
+        if (size > 0) {
+          size_t pos = in.Below(size - 1);
+          auto ei = ea_.erase(ea_.begin() + pos);
+          auto si = st_.erase(st_.begin() + pos);
+          CheckOffset(ei - ea_.begin(), si - st_.begin(), "erase(pos)");
+        }
+        break;
+      case 6: {
+        size_t first = in.Below(size);
+        size_t last = first + in.Below(size - first);
+        auto ei = ea_.erase(ea_.begin() + first, ea_.begin() + last);
+        auto si = st_.erase(st_.begin() + first, st_.begin() + last);
+        CheckOffset(ei - ea_.begin(), si - st_.begin(), "erase(first, last)");
+        break;
+      }
+      case 7: {
+        size_t n = in.Below(80);
+        ea_.resize(n);
+        st_.resize(n);
+        break;
+      }
+      case 8: {
+        size_t n = in.Below(80);
+        T x = Value(in);
+        ea_.resize(n, x);
+        st_.resize(n, x);
+        break;
+      }
+      case 9: {
+        size_t n = in.Below(80);
+        T x = Value(in);
+        ea_.assign(n, x);
+        st_.assign(n, x);
+        break;
+      }
+      case 10: {
+        SVector src = Source(in);
+        ea_.assign(src.data(), src.data() + src.size());
+        st_.assign(src.begin(), src.end());
+        break;
+      }
+      case 11:
+        ea_.swap(eb_);
+        st_.swap(sb_);
+        break;
+      case 12:
+        eb_ = ea_;
+        sb_ = st_;
+        break;
+      case 13: {
+        EVector copy(ea_);
+        eb_.swap(copy);
+        sb_ = st_;
+        break;
+      }
+      case 14:
+        ea_.clear();
+        st_.clear();
+        break;
+      case 15:
+        if (size > 0) {
+          size_t pos = in.Below(size - 1);
+          T x = Value(in);
+          ea_[pos] = x;
+          st_[pos] = x;
+        }
+        break;
+      case 16: {
+        // elements of the container itself as the value
+        if (size > 0) {
+          size_t from = in.Below(size - 1);
+          size_t pos = in.Below(size);
+          size_t n = in.Below(20);
+          if (in.Byte() % 2) {
+            T x = st_[from];
+            ea_.push_back(ea_[from]);
+            st_.push_back(x);
+          }
+          else {
+            T x = st_[from];
+            ea_.insert(ea_.begin() + pos, n, ea_[from]);
+            st_.insert(st_.begin() + pos, n, x);
+          }
+        }
+        break;
+      }
+      case 17: {
+        size_t n = size + in.Below(40);
+        ea_.reserve(n);
+        st_.reserve(n);
+        CheckOffset(static_cast<ptrdiff_t>(ea_.capacity() >= n), 1, "reserve");
+        break;
+      }
+    }
+  }
+
+  SVector Source(DiffInput& in) {
+    SVector src(in.Below(60));
+    for (auto& x : src) { x = Value(in); }
+    return src;
+  }
+
+  void CheckOffset(ptrdiff_t got, ptrdiff_t expect, const char* what) {
+    if (!failed_ && got != expect) {
+      std::cout << " step " << step_ << ": " << what << " returned offset "
+                << got << ", expected " << expect << "\n";
+      failed_ = true;
+    }
+  }
+
+  void Check(EVector& e, SVector& s, const char* name) {
+    if (failed_) { return; }
+    bool same = e.size() == s.size() && e.capacity() >= e.size() &&
+                e.empty() == s.empty();
+    for (size_t i = 0; same && i < s.size(); ++i) {
+      same = e[i] == s[i];
+    }
+    if (!same) {
+      std::cout << " step " << step_ << ": vector " << name << " differs, size "
+                << e.size() << " vs " << s.size() << "\n";
+      failed_ = true;
+    }
+  }
+
+  EVector ea_, eb_;
+  SVector st_, sb_;
+  bool failed_;
+  size_t step_;
+};
+
+// entry used by the fuzzer and by the seeded runs
+inline bool VectorDiffRun(const uint8_t* data, size_t size) {
+  VectorDiffer<int> ints;
+  VectorDiffer<std::string> strings;
+  return ints.Run(data, size) && strings.Run(data, size);
+}
+
+// deterministic seed mode: rounds random inputs from seed
+inline bool VectorDiffTest(uint32_t seed = 20240901, int rounds = 2000)
+{
+  std::cout << "[----------------- vector differential test -----------------]\n";
+  std::mt19937 gen(seed);
+  std::vector<uint8_t> input;
+  int failures = 0;
+  for (int r = 0; r < rounds && failures == 0; ++r) {
+    input.resize(gen() % 2048);
+    for (auto& b : input) { b = static_cast<uint8_t>(gen()); }
+    if (!VectorDiffRun(input.data(), input.size())) {
+      std::cout << " seed " << seed << " round " << r << " failed\n";
+      ++failures;
+    }
+  }
+  FUN_VALUE(seed);
+  FUN_VALUE(rounds);
+  FUN_VALUE(failures);
+  std::cout << "[----------------- End -----------------]\n";
+  return failures == 0;
+}
@@ -0,0 +1,11 @@
+// libFuzzer entry for the vector differential test
+// build with -DEASYSTL_FUZZ=ON using clang, then run
+//   ./bin/vectorfuzz -max_len=4096
+#include <cstdlib>
+#include "vectordifftest.h"
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size)
+{
+  if (!VectorDiffRun(data, size)) { std::abort(); }
+  return 0;
+}
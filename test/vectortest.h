@@ -1,5 +1,8 @@
 #include <vector>
 #include <iostream>
+#include <stdexcept>
+#include <utility>
+#include <cstring>
 #include "test.h"
 #include "vector.h"
 
@@ -53,6 +56,9 @@ void VectorTest()
   FUN_AFTER(v1, v1.resize(6, 6));
   FUN_VALUE(v1.size());
   FUN_VALUE(v1.capacity());
+  FUN_AFTER(v1, v1.reserve(100));
+  FUN_VALUE(v1.size());
+  FUN_VALUE(v1.capacity());
   FUN_AFTER(v1, v1.clear());
   FUN_VALUE(v1.size());
   FUN_VALUE(v1.capacity());
@@ -60,3 +66,216 @@ void VectorTest()
 }
 
 
+
+
+// element whose copy constructor throws on demand
+// live counts every object still alive, so leaks and double
+// destroys both show up as a non zero value at the end
+class ThrowingValue {
+ public:
+  static int live;
+  static int throwafter; // copies left before throwing, -1 for never
+  ThrowingValue(int v = 0) : value(v) { ++live; }
+  ThrowingValue(const ThrowingValue& rhs) : value(rhs.value) {
+    if (throwafter == 0) { throw std::runtime_error("copy"); }
+    if (throwafter > 0) { --throwafter; }
+    ++live;
+  }
+  ThrowingValue& operator=(const ThrowingValue& rhs) {
+    value = rhs.value;
+    return *this;
+  }
+  ~ThrowingValue() { --live; }
+  int value;
+};
+int ThrowingValue::live = 0;
+int ThrowingValue::throwafter = -1;
+
+inline std::ostream& operator<<(std::ostream& os, const ThrowingValue& x) { return os << x.value; }
+
+// copies never throw, the default constructor always does
+class ThrowingDefault {
+ public:
+  ThrowingDefault() { throw std::runtime_error("default"); }
+  explicit ThrowingDefault(int v) noexcept : value(v) {}
+  int value;
+};
+
+// copy construction never throws, copy assignment throws on the
+// same ThrowingValue::throwafter switch
+class ThrowingAssign {
+ public:
+  static int live;
+  ThrowingAssign(int v = 0) noexcept : value(v) { ++live; }
+  ThrowingAssign(const ThrowingAssign& rhs) noexcept : value(rhs.value) { ++live; }
+  ThrowingAssign& operator=(const ThrowingAssign& rhs) {
+    if (ThrowingValue::throwafter == 0) { throw std::runtime_error("assign"); }
+    if (ThrowingValue::throwafter > 0) { --ThrowingValue::throwafter; }
+    value = rhs.value;
+    return *this;
+  }
+  ~ThrowingAssign() { --live; }
+  int value;
+};
+int ThrowingAssign::live = 0;
+
+inline std::ostream& operator<<(std::ostream& os, const ThrowingAssign& x) { return os << x.value; }
+
+// run statement with a copy that throws after n successful copies
+#define THROW_AFTER(n, statement) do {                   \
+  ThrowingValue::throwafter = (n);                       \
+  bool thrown = false;                                   \
+  try { statement; }                                     \
+  catch (const std::runtime_error&) { thrown = true; }   \
+  ThrowingValue::throwafter = -1;                        \
+  std::cout << " " << #statement << " throws : "         \
+            << thrown << "\n";                           \
+} while(0)
+
+void VectorExceptionTest()
+{
+  std::cout << "[----------------- vector exception test -----------------]\n";
+  std::cout << std::boolalpha;
+  FUN_VALUE(noexcept(std::declval<easystl::vector<int>&>().push_back(1)));
+  FUN_VALUE(noexcept(std::declval<easystl::vector<ThrowingValue>&>().push_back(1)));
+  {
+    easystl::vector<ThrowingValue> v1;
+    for (int i = 0; i < 16; ++i) v1.push_back(i);
+    ThrowingValue* olddata = v1.data();
+    // growth copies 16 elements, the 6th copy throws
+    THROW_AFTER(5, v1.push_back(16));
+    FUN_VALUE(v1.size());
+    FUN_VALUE(v1.capacity());
+    FUN_VALUE((v1.data() == olddata));
+    COUT(v1);
+    // the copy of the new element throws
+    THROW_AFTER(0, v1.push_back(16));
+    FUN_VALUE(v1.size());
+    COUT(v1);
+    ThrowingValue a[] = { 100, 101, 102, 103, 104 };
+    THROW_AFTER(18, v1.insert(v1.begin() + 2, a + 0, a + 5));
+    FUN_VALUE(v1.size());
+    COUT(v1);
+    THROW_AFTER(10, v1.insert(v1.begin(), 3, ThrowingValue(7)));
+    FUN_VALUE(v1.size());
+    COUT(v1);
+    THROW_AFTER(3, easystl::vector<ThrowingValue> v2(v1));
+    THROW_AFTER(3, easystl::vector<ThrowingValue> v3(10, ThrowingValue(1)));
+    THROW_AFTER(-1, v1.push_back(16));
+    FUN_VALUE(v1.size());
+    COUT(v1);
+  }
+  FUN_VALUE(ThrowingValue::live);
+  EXPECT(ThrowingValue::live == 0);
+  // throwing assignment propagates out of the members that assign
+  FUN_VALUE(noexcept(std::declval<easystl::vector<ThrowingAssign>&>().erase(nullptr)));
+  EXPECT(!noexcept(std::declval<easystl::vector<ThrowingAssign>&>().erase(nullptr)));
+  EXPECT(!noexcept(easystl::Copy(std::declval<ThrowingAssign*>(), std::declval<ThrowingAssign*>(),
+                                 std::declval<ThrowingAssign*>())));
+  EXPECT(noexcept(easystl::Copy(std::declval<int*>(), std::declval<int*>(), std::declval<int*>())));
+  {
+    easystl::vector<ThrowingAssign> v1;
+    for (int i = 0; i < 10; ++i) v1.push_back(i);
+    v1.reserve(32);
+    easystl::vector<ThrowingAssign> v2(40, ThrowingAssign(9));
+    THROW_AFTER(0, v1.insert(v1.begin(), 1, ThrowingAssign(7)));
+    THROW_AFTER(2, v1.insert(v1.begin() + 1, 20, ThrowingAssign(7)));
+    THROW_AFTER(1, v1.erase(v1.begin()));
+    THROW_AFTER(1, v1.erase(v1.begin(), v1.begin() + 2));
+    THROW_AFTER(1, v2 = v1);
+    THROW_AFTER(1, v1.assign(4, ThrowingAssign(5)));
+    FUN_VALUE(v1.size());
+    FUN_VALUE(v2.size());
+    THROW_AFTER(-1, v1.insert(v1.begin(), 1, ThrowingAssign(7)));
+    FUN_VALUE(v1.front());
+    EXPECT(v1.front().value == 7);
+  }
+  FUN_VALUE(ThrowingAssign::live);
+  EXPECT(ThrowingAssign::live == 0);
+  // nothrow copy, throwing T(): members that build a T() may throw
+  FUN_VALUE(noexcept(easystl::vector<ThrowingDefault>(3)));
+  FUN_VALUE(noexcept(std::declval<easystl::vector<ThrowingDefault>&>().resize(3)));
+  EXPECT(!noexcept(easystl::vector<ThrowingDefault>(3)));
+  EXPECT(!noexcept(std::declval<easystl::vector<ThrowingDefault>&>().resize(3)));
+  EXPECT(noexcept(std::declval<easystl::vector<ThrowingDefault>&>().push_back(ThrowingDefault(1))));
+  {
+    easystl::vector<ThrowingDefault> v1;
+    THROW_AFTER(-1, easystl::vector<ThrowingDefault> v2(3));
+    THROW_AFTER(-1, v1.resize(3));
+    FUN_VALUE(v1.size());
+  }
+  std::cout << std::noboolalpha;
+  std::cout << "[----------------- End -----------------]\n";
+}
+
+// push_back through every growth path and check nothing was lost
+template<class Alloc>
+bool GrowthKeepsData(int n)
+{
+  easystl::vector<int, Alloc> v;
+  for (int i = 0; i < n; ++i) v.push_back(i);
+  v.insert(v.begin() + n / 2, 3, -1);
+  for (int i = 0; i < n / 2; ++i) if (v[i] != i) return false;
+  for (int i = n / 2 + 3; i < n + 3; ++i) if (v[i] != i - 3) return false;
+  return v.size() == static_cast<size_t>(n + 3) && v[n / 2] == -1;
+}
+
+// MallocAllocator that counts Reallocate calls
+class ReallocCountingAllocator {
+ public:
+  static int reallocations;
+  static void* Allocate(size_t size) { return easystl::MallocAllocator::Allocate(size); }
+  static void Deallocate(void* obj, size_t size) { easystl::MallocAllocator::Deallocate(obj, size); }
+  static void* Reallocate(void* obj, size_t oldsize, size_t newsize) {
+    ++reallocations;
+    return easystl::MallocAllocator::Reallocate(obj, oldsize, newsize);
+  }
+};
+int ReallocCountingAllocator::reallocations = 0;
+
+// range insert that has to grow, from outside and from inside the block
+bool RangeInsertGrowth()
+{
+  using Vector = easystl::vector<int, ReallocCountingAllocator>;
+  Vector v;
+  for (int i = 0; i < 16; ++i) v.push_back(i);
+  int a[] = { 100, 101, 102, 103 };
+  ReallocCountingAllocator::reallocations = 0;
+  v.insert(v.begin() + 2, a, a + 4);
+  bool ok = ReallocCountingAllocator::reallocations == 1 && v.size() == 20 &&
+            v[1] == 1 && v[2] == 100 && v[5] == 103 && v[6] == 2 && v[19] == 15;
+  while (v.size() < v.capacity()) v.push_back(-1);
+  const size_t size = v.size();
+  v.insert(v.begin(), v.begin() + 2, v.begin() + 6);
+  ok = ok && v.size() == size + 4 && v[0] == 100 && v[3] == 103 && v[4] == 0 && v[6] == 100;
+  return ok;
+}
+
+void VectorReallocTest()
+{
+  std::cout << "[----------------- vector realloc test -----------------]\n";
+  std::cout << std::boolalpha;
+  const bool mallockept = GrowthKeepsData<easystl::MallocAllocator>(1000000);
+  FUN_VALUE(mallockept);
+  EXPECT(mallockept);
+  const bool poolkept = GrowthKeepsData<easystl::MemoryPoolAllocator>(1000000);
+  FUN_VALUE(poolkept);
+  EXPECT(poolkept);
+#ifdef __linux__
+  const bool mmapkept = GrowthKeepsData<easystl::MmapAllocator>(1000000);
+  FUN_VALUE(mmapkept);
+  EXPECT(mmapkept);
+#endif
+  FUN_VALUE(RangeInsertGrowth());
+  EXPECT(RangeInsertGrowth());
+  // pool blocks grow across the small size classes
+  void* p = easystl::MemoryPoolAllocator::Allocate(8);
+  std::memcpy(p, "easystl", 8);
+  p = easystl::MemoryPoolAllocator::Reallocate(p, 8, 64);
+  p = easystl::MemoryPoolAllocator::Reallocate(p, 64, 256);
+  FUN_VALUE((std::strcmp(static_cast<char*>(p), "easystl") == 0));
+  EXPECT(std::strcmp(static_cast<char*>(p), "easystl") == 0);
+  easystl::MemoryPoolAllocator::Deallocate(p, 256);
+  std::cout << std::noboolalpha;
+  std::cout << "[----------------- End -----------------]\n";
+}
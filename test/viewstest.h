@@ -0,0 +1,95 @@
+#include <iostream>
+#include <string>
+#include "test.h"
+#include "vector.h"
+#include "stable_vector.h"
+#include "views.h"
+
+// single pass source: every copy reads from the same cursor,
+// like a stream, so walking it twice loses the elements
+class CountdownIterator : public easystl::Iterator<easystl::InputIteratorTag, int> {
+ public:
+  CountdownIterator() : left_(nullptr) {}
+  explicit CountdownIterator(int* left) : left_(left) {}
+  int operator*() const { return *left_; }
+  CountdownIterator& operator++() { --*left_; return *this; }
+  bool operator==(const CountdownIterator& rhs) const { return Done() == rhs.Done(); }
+  bool operator!=(const CountdownIterator& rhs) const { return !(*this == rhs); }
+
+ private:
+  bool Done() const { return nullptr == left_ || *left_ == 0; }
+  int* left_;
+};
+
+static_assert(easystl::views::HasSize<easystl::views::IterRange<int*>>::value, "pointer range has a size");
+static_assert(!easystl::views::HasSize<easystl::views::IterRange<CountdownIterator>>::value,
+              "single pass range has no size");
+
+void ViewsTest()
+{
+  std::cout << "[----------------- views test -----------------]\n";
+  using namespace easystl;
+  vector<int> v1{ 1,2,3,4,5,6,7,8,9,10 };
+  stable_vector<int> s1;
+  for (int i = 0; i < 40; ++i) s1.push_back(i);
+  const char* names[] = { "a", "b", "c", "d" };
+  auto odd = [](int x) { return x % 2 != 0; };
+  auto square = [](int x) { return x * x; };
+
+  COUT(v1);
+  COUT(v1 | views::filter(odd));
+  COUT(v1 | views::transform(square));
+  COUT(v1 | views::take(3));
+  COUT(v1 | views::take(30));
+  COUT(v1 | views::drop(7));
+  COUT(v1 | views::drop(30));
+  EXPECT(*(v1 | views::drop(7)).begin() == 8);
+  EXPECT((v1 | views::drop(30)).begin() == v1.end());
+  EXPECT((s1 | views::drop(39)).begin() == s1.end() - 1);
+  EXPECT((s1 | views::drop(41)).begin() == s1.end());
+  EXPECT(*(v1 | views::filter(odd) | views::drop(2)).begin() == 5);
+  COUT(v1 | views::filter(odd) | views::transform(square) | views::take(3));
+  COUT(s1 | views::drop(10) | views::filter(odd) | views::take(5));
+  COUT(views::range(names + 1, names + 4) | views::take(2));
+  // a filter after take only sees the first elements
+  COUT(v1 | views::take(4) | views::filter(odd));
+  auto first3 = v1 | views::take(3);
+  FUN_VALUE(first3.size());
+  auto shifted = views::range(s1.begin(), s1.end()) | views::drop(35);
+  FUN_VALUE(shifted.size());
+  std::cout << " enumerate :";
+  views::ForEach(v1 | views::drop(8) | views::enumerate(), [](std::pair<size_t, int&> p) {
+    std::cout << " " << p.first << ":" << p.second;
+  });
+  std::cout << "\n zip :";
+  views::ForEach(v1 | views::zip(views::range(names, names + 4)), [](std::pair<int&, const char*&> p) {
+    std::cout << " " << p.first << p.second;
+  });
+  std::cout << "\n chunk :";
+  views::ForEach(v1 | views::chunk(4), [](views::IterRange<int*> c) {
+    std::cout << " [";
+    for (int x : c) std::cout << " " << x;
+    std::cout << " ]";
+  });
+  std::cout << "\n";
+  FUN_VALUE((v1 | views::chunk(4)).size());
+  // elements are references, so a pipeline can write through
+  views::ForEach(v1 | views::filter(odd), [](int& x) { x = -x; });
+  COUT(v1);
+  vector<int> r1 = v1 | views::transform(square) | views::drop(2) | views::to_vector;
+  COUT(r1);
+  FUN_VALUE(r1.capacity());
+  vector<int> r2 = views::ToVector(v1 | views::filter(odd));
+  COUT(r2);
+  vector<std::string> r3 = views::ToVector(views::range(names, names + 4) |
+    views::transform([](const char* s) { return std::string(s) + s; }));
+  COUT(r3);
+  FUN_VALUE(r3.capacity());
+  // materializing a single pass range reads it exactly once
+  int left = 5;
+  vector<int> r4 = views::ToVector(views::range(CountdownIterator(&left), CountdownIterator()) |
+    views::transform(square));
+  COUT(r4);
+  EXPECT(r4.size() == 5 && r4[0] == 25 && r4[4] == 1);
+  std::cout << "[----------------- End -----------------]\n";
+}